@@ -0,0 +1,160 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_oop.h"
+
+// Every allocation made by the benchmark binary goes through these
+// replacements, so each benchmark can report how many it made per
+// iteration.
+
+namespace {
+
+std::atomic<long> allocation_count{0};
+
+void* CountedAllocate(std::size_t size, std::size_t alignment) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  size = (size + alignment - 1) / alignment * alignment;
+  void* ptr = std::aligned_alloc(alignment, size == 0 ? alignment : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return (ptr);
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  return (CountedAllocate(size, alignof(std::max_align_t)));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return (CountedAllocate(size, static_cast<std::size_t>(alignment)));
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+
+void SetAllocationCounter(benchmark::State& state, long before) {
+  state.counters["allocs"] = benchmark::Counter(
+      static_cast<double>(allocation_count.load() - before),
+      benchmark::Counter::kAvgIterations);
+}
+
+// A fresh n x n temporary per iteration; sizes up to 4 x 4 fit the inline
+// buffer, larger ones go to the heap.
+void BM_Temporary(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  long before = allocation_count.load();
+
+  for (auto _ : state) {
+    S21Matrix m(n, n);
+    benchmark::DoNotOptimize(m);
+  }
+  SetAllocationCounter(state, before);
+}
+
+void BM_CopyTemporary(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix m(n, n);
+  long before = allocation_count.load();
+
+  for (auto _ : state) {
+    S21Matrix copy(m);
+    benchmark::DoNotOptimize(copy);
+  }
+  SetAllocationCounter(state, before);
+}
+
+// CalcComplements creates one minor per element, so it is dominated by
+// temporaries for small matrices.
+void BM_CalcComplementsTemporaries(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i) {
+    m(i, i) = 2.0;
+    m(i, (i + 1) % n) = 1.0;
+  }
+  long before = allocation_count.load();
+
+  for (auto _ : state) {
+    S21Matrix complements = m.CalcComplements();
+    benchmark::DoNotOptimize(complements);
+  }
+  SetAllocationCounter(state, before);
+}
+
+// The whole expression is evaluated into the result in one pass, so each
+// iteration allocates only the result.
+void BM_ChainedExpression(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n), b(n, n), c(n, n);
+  long before = allocation_count.load();
+
+  for (auto _ : state) {
+    S21Matrix result = a + b - c * 2.0;
+    benchmark::DoNotOptimize(result);
+  }
+  SetAllocationCounter(state, before);
+}
+
+// The same temporaries from the system allocator, the pool and an arena,
+// chosen by the second argument.
+void BM_AllocatorTemporaries(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21MatrixArena arena;
+  S21MatrixAllocator* allocators[] = {&S21MatrixAllocator::System(),
+                                      &S21MatrixAllocator::Pool(), &arena};
+  S21MatrixAllocatorScope scope(*allocators[state.range(1)]);
+  S21Matrix a(n, n), b(n, n);
+  long before = allocation_count.load();
+
+  for (auto _ : state) {
+    S21Matrix sum = a + b;
+    S21Matrix transposed = sum.Transpose();
+    benchmark::DoNotOptimize(transposed);
+  }
+  SetAllocationCounter(state, before);
+}
+
+void BM_AllocatorCalcComplements(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21MatrixArena arena;
+  S21MatrixAllocator* allocators[] = {&S21MatrixAllocator::System(),
+                                      &S21MatrixAllocator::Pool(), &arena};
+  S21MatrixAllocatorScope scope(*allocators[state.range(1)]);
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i) {
+    m(i, i) = 2.0;
+    m(i, (i + 1) % n) = 1.0;
+  }
+  long before = allocation_count.load();
+
+  for (auto _ : state) {
+    S21Matrix complements = m.CalcComplements();
+    benchmark::DoNotOptimize(complements);
+  }
+  SetAllocationCounter(state, before);
+}
+
+}  // namespace
+
+BENCHMARK(BM_Temporary)->DenseRange(1, 6);
+BENCHMARK(BM_CopyTemporary)->DenseRange(1, 6);
+BENCHMARK(BM_CalcComplementsTemporaries)->DenseRange(2, 5);
+BENCHMARK(BM_ChainedExpression)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK(BM_AllocatorTemporaries)->ArgsProduct({{8, 64, 256}, {0, 1, 2}});
+BENCHMARK(BM_AllocatorCalcComplements)->ArgsProduct({{6, 7}, {0, 1, 2}});
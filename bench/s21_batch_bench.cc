@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "s21_matrix_batch.h"
+
+namespace {
+
+const int kBatchCount = 4096;
+
+S21Matrix MakeMatrix(int n, int seed) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      m(i, j) = ((i * 7 + j * 3 + seed) % 11 - 5.0) / 4.0 + (i == j ? 4 : 0);
+    }
+  }
+
+  return (m);
+}
+
+void SetMatrixCounter(benchmark::State& state) {
+  state.counters["matrices/s"] = benchmark::Counter(
+      static_cast<double>(kBatchCount) * state.iterations(),
+      benchmark::Counter::kIsRate);
+}
+
+// One S21Matrix per problem, the way callers did it before the batch type.
+void BM_InverseOneByOne(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  std::vector<S21Matrix> matrices;
+  for (int b = 0; b < kBatchCount; ++b) {
+    matrices.push_back(MakeMatrix(n, b));
+  }
+  for (auto _ : state) {
+    for (const S21Matrix& m : matrices) {
+      benchmark::DoNotOptimize(m.InverseMatrix());
+    }
+  }
+  SetMatrixCounter(state);
+}
+BENCHMARK(BM_InverseOneByOne)->Arg(3)->Arg(4);
+
+void BM_InverseBatched(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21MatrixBatch batch(kBatchCount, n, n,
+                       static_cast<S21MatrixBatch::Layout>(state.range(1)));
+  for (int b = 0; b < kBatchCount; ++b) {
+    batch.Set(b, MakeMatrix(n, b));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(batch.InverseMatrix());
+  }
+  SetMatrixCounter(state);
+}
+BENCHMARK(BM_InverseBatched)->ArgsProduct({{3, 4}, {0, 1}});
+
+void BM_DeterminantBatched(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21MatrixBatch batch(kBatchCount, n, n);
+  for (int b = 0; b < kBatchCount; ++b) {
+    batch.Set(b, MakeMatrix(n, b));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(batch.Determinant());
+  }
+  SetMatrixCounter(state);
+}
+BENCHMARK(BM_DeterminantBatched)->Arg(3)->Arg(4);
+
+void BM_ProductBatched(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21MatrixBatch lhs(kBatchCount, n, n);
+  S21MatrixBatch rhs(kBatchCount, n, n);
+  for (int b = 0; b < kBatchCount; ++b) {
+    lhs.Set(b, MakeMatrix(n, b));
+    rhs.Set(b, MakeMatrix(n, b + 1));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs * rhs);
+  }
+  SetMatrixCounter(state);
+}
+BENCHMARK(BM_ProductBatched)->Arg(3)->Arg(4);
+
+}  // namespace
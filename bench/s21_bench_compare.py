@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+"""Compares two Google Benchmark JSON files and fails on regressions.
+
+Every repetition of a benchmark is one sample of its time. A benchmark has
+regressed when its current samples are slower than the baseline ones by a
+one-sided Mann-Whitney U test at level --alpha and its median time grew by
+more than --threshold. The test keeps run-to-run noise from failing the
+check; the threshold keeps significant but negligible changes from failing
+it. Benchmarks with too few repetitions for the test to ever reach --alpha,
+one run each for instance, are judged by the threshold alone.
+
+Usage: s21_bench_compare.py [options] BASELINE CURRENT
+Exits with 0 when nothing regressed, 1 when something did, 2 on bad input.
+Only the Python standard library is used.
+"""
+
+import argparse
+import json
+import math
+import statistics
+import sys
+
+# Sample sizes up to which the exact distribution of U is used.
+EXACT_MAX_SAMPLES = 30
+
+NANOSECONDS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def fail(message):
+    print(f"error: {message}", file=sys.stderr)
+    sys.exit(2)
+
+
+def load_samples(path, metric):
+    """Returns {benchmark name: [times in ns]} of the iteration runs."""
+    try:
+        with open(path, encoding="utf-8") as file:
+            data = json.load(file)
+    except OSError as error:
+        fail(f"cannot read {path}: {error.strerror}")
+    except json.JSONDecodeError as error:
+        fail(f"{path} is not valid JSON: {error}")
+
+    samples = {}
+    for run in data.get("benchmarks", []):
+        if run.get("run_type", "iteration") != "iteration":
+            continue
+        if "error_occurred" in run and run["error_occurred"]:
+            continue
+        name = run.get("run_name", run["name"])
+        scale = NANOSECONDS[run.get("time_unit", "ns")]
+        samples.setdefault(name, []).append(run[metric] * scale)
+    if not samples:
+        fail(f"{path} holds no benchmark runs")
+
+    return samples
+
+
+def ranks(values):
+    """Ranks starting at 1, ties sharing their mean rank."""
+    order = sorted(range(len(values)), key=lambda i: values[i])
+    result = [0.0] * len(values)
+    tie_sizes = []
+    i = 0
+    while i < len(order):
+        j = i
+        while j + 1 < len(order) and values[order[j + 1]] == values[order[i]]:
+            j += 1
+        for k in range(i, j + 1):
+            result[order[k]] = (i + j) / 2.0 + 1.0
+        if j > i:
+            tie_sizes.append(j - i + 1)
+        i = j + 1
+
+    return result, tie_sizes
+
+
+def exact_upper_tail(u, m, n):
+    """P(U >= u) for m and n samples without ties.
+
+    counts[j][s] counts the orderings of the values placed so far among j
+    others in which they exceed s pairs; the m values are added one at a
+    time.
+    """
+    counts = [[1] for _ in range(n + 1)]
+    for _ in range(m):
+        next_counts = [[1]]
+        for j in range(1, n + 1):
+            left = next_counts[j - 1]
+            below = counts[j]
+            size = max(len(left), len(below) + j)
+            row = [0] * size
+            for s, count in enumerate(left):
+                row[s] += count
+            for s, count in enumerate(below):
+                row[s + j] += count
+            next_counts.append(row)
+        counts = next_counts
+    distribution = counts[n]
+    total = sum(distribution)
+    tail = sum(distribution[math.ceil(u):])
+
+    return tail / total
+
+
+def slower_p_value(baseline, current):
+    """One-sided Mann-Whitney p-value that current is slower than baseline."""
+    m, n = len(current), len(baseline)
+    rank, tie_sizes = ranks(current + baseline)
+    u = sum(rank[:m]) - m * (m + 1) / 2.0
+    if not tie_sizes and max(m, n) <= EXACT_MAX_SAMPLES:
+        return exact_upper_tail(u, m, n)
+
+    total = m + n
+    ties = sum(t ** 3 - t for t in tie_sizes)
+    variance = m * n / 12.0 * ((total + 1) - ties / (total * (total - 1)))
+    if variance == 0.0:
+        return 1.0
+    z = (u - m * n / 2.0 - 0.5) / math.sqrt(variance)
+
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+def testable_at(m, n, alpha):
+    """Whether m and n samples can give a p-value below alpha at all.
+
+    The smallest one is that of all current samples exceeding all baseline
+    ones, 1 / C(m + n, m): 5 repetitions a side are needed for alpha = 0.01.
+    """
+    return m > 0 and n > 0 and 1.0 / math.comb(m + n, m) < alpha
+
+
+def format_time(ns):
+    for unit in ("s", "ms", "us"):
+        if ns >= NANOSECONDS[unit]:
+            return f"{ns / NANOSECONDS[unit]:.3f} {unit}"
+    return f"{ns:.1f} ns"
+
+
+def compare(baseline, current, threshold, alpha):
+    """Returns the report rows and the number of regressions."""
+    rows = []
+    regressions = 0
+    for name in sorted(set(baseline) | set(current), key=natural_key):
+        if name not in current:
+            rows.append((name, format_time(statistics.median(baseline[name])),
+                         "-", "-", "-", "missing"))
+            continue
+        if name not in baseline:
+            rows.append((name, "-",
+                         format_time(statistics.median(current[name])), "-",
+                         "-", "new"))
+            continue
+
+        old = statistics.median(baseline[name])
+        new = statistics.median(current[name])
+        change = new / old - 1.0 if old > 0.0 else 0.0
+        testable = testable_at(len(baseline[name]), len(current[name]), alpha)
+        p_value = None
+        if testable:
+            p_value = slower_p_value(baseline[name], current[name])
+        if change > threshold and (p_value is None or p_value < alpha):
+            status = "REGRESSED"
+            regressions += 1
+        elif testable and change < -threshold and \
+                slower_p_value(current[name], baseline[name]) < alpha:
+            status = "improved"
+        else:
+            status = "ok"
+        rows.append((name, format_time(old), format_time(new),
+                     f"{change * 100.0:+.1f}%",
+                     "-" if p_value is None else f"{p_value:.4f}", status))
+
+    return rows, regressions
+
+
+def natural_key(name):
+    """Orders BM_X/rows:16 before BM_X/rows:256."""
+    key = []
+    number = ""
+    for char in name + "\0":
+        if char.isdigit():
+            number += char
+            continue
+        if number:
+            key.append((1, int(number), ""))
+            number = ""
+        key.append((0, 0, char))
+
+    return key
+
+
+def print_report(rows, regressions, threshold, alpha):
+    header = ("Benchmark", "Baseline", "Current", "Change", "p", "Status")
+    widths = [max(len(row[i]) for row in rows + [header])
+              for i in range(len(header))]
+    line = "  ".join(f"{{:<{widths[0]}}}" if i == 0 else f"{{:>{w}}}"
+                     for i, w in enumerate(widths))
+    print(line.format(*header))
+    print("-" * (sum(widths) + 2 * (len(widths) - 1)))
+    for row in rows:
+        print(line.format(*row))
+    print()
+    if regressions:
+        print(f"{regressions} benchmark(s) regressed: median time up more "
+              f"than {threshold * 100.0:g}% at p < {alpha:g}.")
+    else:
+        print(f"No regressions: no median time up more than "
+              f"{threshold * 100.0:g}% at p < {alpha:g}.")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Fails when CURRENT benchmarks regressed from BASELINE.")
+    parser.add_argument("baseline", help="Google Benchmark JSON to compare to")
+    parser.add_argument("current", help="Google Benchmark JSON to check")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative growth of the median time allowed, "
+                             "default 0.10")
+    parser.add_argument("--alpha", type=float, default=0.01,
+                        help="significance level of the test, default 0.01")
+    parser.add_argument("--metric", choices=("real_time", "cpu_time"),
+                        default="real_time",
+                        help="time compared, default real_time")
+    args = parser.parse_args()
+
+    baseline = load_samples(args.baseline, args.metric)
+    current = load_samples(args.current, args.metric)
+    rows, regressions = compare(baseline, current, args.threshold, args.alpha)
+    print_report(rows, regressions, args.threshold, args.alpha)
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace {
+
+void FillMatrix(S21Matrix& m) {
+  for (int i = 0; i < m.rows(); ++i) {
+    for (int j = 0; j < m.cols(); ++j) {
+      m(i, j) = ((i * 31 + j * 17) % 19 - 9.0) / 8.0;
+    }
+  }
+}
+
+void SetFlopsCounter(benchmark::State& state, int n) {
+  state.counters["FLOP/s"] = benchmark::Counter(
+      2.0 * n * n * n * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+// The i-j-k loop MulMatrix used before the blocked kernel, on the same
+// contiguous row-major layout.
+void BM_MulMatrixNaive(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix ma(n, n);
+  S21Matrix mb(n, n);
+  FillMatrix(ma);
+  FillMatrix(mb);
+  std::vector<double> a(static_cast<std::size_t>(n) * n);
+  std::vector<double> b(a.size());
+  std::vector<double> c(a.size());
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a[i * n + j] = ma(i, j);
+      b[i * n + j] = mb(i, j);
+    }
+  }
+
+  for (auto _ : state) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        double sum = 0.0;
+        for (int k = 0; k < n; ++k) {
+          sum += a[i * n + k] * b[k * n + j];
+        }
+        c[i * n + j] = sum;
+      }
+    }
+    benchmark::DoNotOptimize(c.data());
+    benchmark::ClobberMemory();
+  }
+  SetFlopsCounter(state, n);
+}
+
+void BM_MulMatrix(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n);
+  S21Matrix b(n, n);
+  FillMatrix(a);
+  FillMatrix(b);
+
+  for (auto _ : state) {
+    S21Matrix c(a);
+    c.MulMatrix(b);
+    benchmark::DoNotOptimize(c);
+  }
+  SetFlopsCounter(state, n);
+}
+
+void BM_OperatorMul(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n);
+  S21Matrix b(n, n);
+  FillMatrix(a);
+  FillMatrix(b);
+
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c);
+  }
+  SetFlopsCounter(state, n);
+}
+
+// FLOP/s counts the 2n^3 flops of the standard product, so that the rates
+// compare directly with BM_MulMatrix.
+void BM_MulMatrixStrassen(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a(n, n);
+  S21Matrix b(n, n);
+  FillMatrix(a);
+  FillMatrix(b);
+
+  for (auto _ : state) {
+    S21Matrix c(a);
+    c.MulMatrix(b, S21Matrix::Multiplication::kStrassen);
+    benchmark::DoNotOptimize(c);
+  }
+  SetFlopsCounter(state, n);
+}
+
+}  // namespace
+
+BENCHMARK(BM_MulMatrixNaive)
+    ->RangeMultiplier(2)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MulMatrix)
+    ->RangeMultiplier(2)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_OperatorMul)
+    ->RangeMultiplier(2)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MulMatrixStrassen)
+    ->RangeMultiplier(2)
+    ->Range(256, 4096)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,353 @@
+#include <benchmark/benchmark.h>
+
+#include <complex>
+#include <cstdint>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+// One benchmark per public operation of S21Matrix, over square and
+// rectangular shapes. Every benchmark reports bytes/s for the elements it
+// reads and writes, and the arithmetic ones FLOP/s; `make bench` saves the
+// results as JSON.
+
+namespace {
+
+template <typename T = double>
+S21BasicMatrix<T> MakeMatrix(int rows, int cols) {
+  S21BasicMatrix<T> m(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      m(i, j) = T(((i * 31 + j * 17) % 19 - 9.0) / 8.0 + (i == j ? cols : 0));
+    }
+  }
+
+  return (m);
+}
+
+// elements and flops are per iteration; zero leaves the counter out.
+void SetCounters(benchmark::State& state, double elements, double flops,
+                 std::size_t element_size = sizeof(double)) {
+  if (elements > 0.0) {
+    state.SetBytesProcessed(static_cast<int64_t>(
+        elements * element_size * static_cast<double>(state.iterations())));
+  }
+  if (flops > 0.0) {
+    state.counters["FLOP/s"] = benchmark::Counter(
+        flops * state.iterations(), benchmark::Counter::kIsRate);
+  }
+}
+
+void Shapes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgNames({"rows", "cols"});
+  for (int n : {4, 16, 64, 256, 1024}) {
+    benchmark->Args({n, n});
+  }
+  benchmark->Args({16, 1024})->Args({1024, 16})->Args({3, 4096});
+}
+
+void SquareSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgName("n")->RangeMultiplier(4)->Range(4, 1024);
+}
+
+void BM_ConstructDefault(benchmark::State& state) {
+  for (auto _ : state) {
+    S21Matrix m;
+    benchmark::DoNotOptimize(m);
+  }
+  SetCounters(state, S21Matrix::kDefaultRows * S21Matrix::kDefaultCols, 0.0);
+}
+BENCHMARK(BM_ConstructDefault);
+
+void BM_Construct(benchmark::State& state) {
+  int rows = static_cast<int>(state.range(0));
+  int cols = static_cast<int>(state.range(1));
+  for (auto _ : state) {
+    S21Matrix m(rows, cols);
+    benchmark::DoNotOptimize(m);
+  }
+  SetCounters(state, static_cast<double>(rows) * cols, 0.0);
+}
+BENCHMARK(BM_Construct)->Apply(Shapes);
+
+void BM_Copy(benchmark::State& state) {
+  int rows = static_cast<int>(state.range(0));
+  int cols = static_cast<int>(state.range(1));
+  S21Matrix m = MakeMatrix(rows, cols);
+  for (auto _ : state) {
+    S21Matrix copy(m);
+    benchmark::DoNotOptimize(copy);
+  }
+  SetCounters(state, 2.0 * rows * cols, 0.0);
+}
+BENCHMARK(BM_Copy)->Apply(Shapes);
+
+void BM_CopyAssign(benchmark::State& state) {
+  int rows = static_cast<int>(state.range(0));
+  int cols = static_cast<int>(state.range(1));
+  S21Matrix m = MakeMatrix(rows, cols);
+  S21Matrix copy(rows, cols);
+  for (auto _ : state) {
+    copy = m;
+    benchmark::DoNotOptimize(copy);
+  }
+  SetCounters(state, 2.0 * rows * cols, 0.0);
+}
+BENCHMARK(BM_CopyAssign)->Apply(Shapes);
+
+// Two moves per iteration, there and back.
+void BM_Move(benchmark::State& state) {
+  int rows = static_cast<int>(state.range(0));
+  int cols = static_cast<int>(state.range(1));
+  S21Matrix m = MakeMatrix(rows, cols);
+  for (auto _ : state) {
+    S21Matrix moved(std::move(m));
+    m = std::move(moved);
+    benchmark::DoNotOptimize(m);
+  }
+  SetCounters(state, 0.0, 0.0);
+}
+BENCHMARK(BM_Move)->Apply(Shapes);
+
+// Grows by one row and shrinks back, copying the elements each time.
+void BM_SetRows(benchmark::State& state) {
+  int rows = static_cast<int>(state.range(0));
+  int cols = static_cast<int>(state.range(1));
+  S21Matrix m = MakeMatrix(rows, cols);
+  for (auto _ : state) {
+    m.set_rows(rows + 1);
+    m.set_rows(rows);
+    benchmark::DoNotOptimize(m);
+  }
+  SetCounters(state, 4.0 * rows * cols, 0.0);
+}
+BENCHMARK(BM_SetRows)->Apply(Shapes);
+
+void BM_SetCols(benchmark::State& state) {
+  int rows = static_cast<int>(state.range(0));
+  int cols = static_cast<int>(state.range(1));
+  S21Matrix m = MakeMatrix(rows, cols);
+  for (auto _ : state) {
+    m.set_cols(cols + 1);
+    m.set_cols(cols);
+    benchmark::DoNotOptimize(m);
+  }
+  SetCounters(state, 4.0 * rows * cols, 0.0);
+}
+BENCHMARK(BM_SetCols)->Apply(Shapes);
+
+// Element fill through the checked operator(), the unchecked At and the row
+// pointers of Rows().
+void BM_FillChecked(benchmark::State& state) {
+  int rows = static_cast<int>(state.range(0));
+  int cols = static_cast<int>(state.range(1));
+  S21Matrix m(rows, cols);
+  for (auto _ : state) {
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) {
+        m(i, j) = i + j;
+      }
+    }
+    benchmark::DoNotOptimize(m);
+  }
+  SetCounters(state, static_cast<double>(rows) * cols, 0.0);
+}
+BENCHMARK(BM_FillChecked)->Apply(Shapes);
+
+void BM_FillAt(benchmark::State& state) {
+  int rows = static_cast<int>(state.range(0));
+  int cols = static_cast<int>(state.range(1));
+  S21Matrix m(rows, cols);
+  for (auto _ : state) {
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) {
+        m.At(i, j) = i + j;
+      }
+    }
+    benchmark::DoNotOptimize(m);
+  }
+  SetCounters(state, static_cast<double>(rows) * cols, 0.0);
+}
+BENCHMARK(BM_FillAt)->Apply(Shapes);
+
+void BM_FillRows(benchmark::State& state) {
+  int rows = static_cast<int>(state.range(0));
+  int cols = static_cast<int>(state.range(1));
+  S21Matrix m(rows, cols);
+  for (auto _ : state) {
+    int i = 0;
+    for (double* row : m.Rows()) {
+      for (int j = 0; j < cols; ++j) {
+        row[j] = i + j;
+      }
+      ++i;
+    }
+    benchmark::DoNotOptimize(m);
+  }
+  SetCounters(state, static_cast<double>(rows) * cols, 0.0);
+}
+BENCHMARK(BM_FillRows)->Apply(Shapes);
+
+void BM_EqMatrix(benchmark::State& state) {
+  int rows = static_cast<int>(state.range(0));
+  int cols = static_cast<int>(state.range(1));
+  S21Matrix a = MakeMatrix(rows, cols);
+  S21Matrix b(a);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.EqMatrix(b));
+  }
+  SetCounters(state, 2.0 * rows * cols, 0.0);
+}
+BENCHMARK(BM_EqMatrix)->Apply(Shapes);
+
+void BM_SumMatrix(benchmark::State& state) {
+  int rows = static_cast<int>(state.range(0));
+  int cols = static_cast<int>(state.range(1));
+  S21Matrix a = MakeMatrix(rows, cols);
+  S21Matrix b = MakeMatrix(rows, cols);
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::DoNotOptimize(a);
+  }
+  SetCounters(state, 3.0 * rows * cols, static_cast<double>(rows) * cols);
+}
+BENCHMARK(BM_SumMatrix)->Apply(Shapes);
+
+void BM_SubMatrix(benchmark::State& state) {
+  int rows = static_cast<int>(state.range(0));
+  int cols = static_cast<int>(state.range(1));
+  S21Matrix a = MakeMatrix(rows, cols);
+  S21Matrix b = MakeMatrix(rows, cols);
+  for (auto _ : state) {
+    a.SubMatrix(b);
+    benchmark::DoNotOptimize(a);
+  }
+  SetCounters(state, 3.0 * rows * cols, static_cast<double>(rows) * cols);
+}
+BENCHMARK(BM_SubMatrix)->Apply(Shapes);
+
+void BM_MulNumber(benchmark::State& state) {
+  int rows = static_cast<int>(state.range(0));
+  int cols = static_cast<int>(state.range(1));
+  S21Matrix a = MakeMatrix(rows, cols);
+  for (auto _ : state) {
+    a.MulMatrix(-1.0);
+    benchmark::DoNotOptimize(a);
+  }
+  SetCounters(state, 2.0 * rows * cols, static_cast<double>(rows) * cols);
+}
+BENCHMARK(BM_MulNumber)->Apply(Shapes);
+
+// An m x k matrix times a k x n one; square products are also covered by
+// bench/s21_gemm_bench.cc.
+void BM_MulMatrix(benchmark::State& state) {
+  int m = static_cast<int>(state.range(0));
+  int k = static_cast<int>(state.range(1));
+  int n = static_cast<int>(state.range(2));
+  S21Matrix a = MakeMatrix(m, k);
+  S21Matrix b = MakeMatrix(k, n);
+  for (auto _ : state) {
+    S21Matrix product(a);
+    product.MulMatrix(b);
+    benchmark::DoNotOptimize(product);
+  }
+  SetCounters(state,
+              static_cast<double>(m) * k + static_cast<double>(k) * n +
+                  static_cast<double>(m) * n,
+              2.0 * m * k * n);
+}
+BENCHMARK(BM_MulMatrix)
+    ->ArgNames({"m", "k", "n"})
+    ->Args({4, 4, 4})
+    ->Args({64, 64, 64})
+    ->Args({256, 256, 256})
+    ->Args({1024, 16, 1024})
+    ->Args({16, 1024, 16})
+    ->Args({1024, 1024, 16})
+    ->Args({3, 4096, 3});
+
+void BM_Transpose(benchmark::State& state) {
+  int rows = static_cast<int>(state.range(0));
+  int cols = static_cast<int>(state.range(1));
+  S21Matrix a = MakeMatrix(rows, cols);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.Transpose());
+  }
+  SetCounters(state, 2.0 * rows * cols, 0.0);
+}
+BENCHMARK(BM_Transpose)->Apply(Shapes);
+
+void BM_Determinant(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = MakeMatrix(n, n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.Determinant());
+  }
+  SetCounters(state, static_cast<double>(n) * n, 2.0 * n * n * n / 3.0);
+}
+BENCHMARK(BM_Determinant)->Apply(SquareSizes)->Arg(3);
+
+// One determinant of order n - 1 per element.
+void BM_CalcComplements(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = MakeMatrix(n, n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.CalcComplements());
+  }
+  double minor = n - 1.0;
+  SetCounters(state, 2.0 * n * n, n * n * 2.0 * minor * minor * minor / 3.0);
+}
+BENCHMARK(BM_CalcComplements)
+    ->ArgName("n")
+    ->DenseRange(2, 5)
+    ->Arg(16)
+    ->Arg(32);
+
+void BM_InverseMatrix(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = MakeMatrix(n, n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.InverseMatrix());
+  }
+  SetCounters(state, 2.0 * n * n, 2.0 * n * n * n);
+}
+BENCHMARK(BM_InverseMatrix)->Apply(SquareSizes);
+
+// SumMatrix and MulMatrix for every element type. Float moves half the
+// bytes of double through kernels with twice the lanes; long double and
+// complex run scalar loops. FLOP/s counts operations on elements, so a
+// complex multiply-add counts as two like a real one.
+template <typename T>
+void BM_SumMatrixOf(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21BasicMatrix<T> a = MakeMatrix<T>(n, n);
+  S21BasicMatrix<T> b = MakeMatrix<T>(n, n);
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::DoNotOptimize(a);
+  }
+  SetCounters(state, 3.0 * n * n, static_cast<double>(n) * n, sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_SumMatrixOf, float)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_SumMatrixOf, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_SumMatrixOf, long double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_SumMatrixOf, std::complex<double>)->Apply(SquareSizes);
+
+template <typename T>
+void BM_MulMatrixOf(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21BasicMatrix<T> a = MakeMatrix<T>(n, n);
+  S21BasicMatrix<T> b = MakeMatrix<T>(n, n);
+  for (auto _ : state) {
+    S21BasicMatrix<T> product(a);
+    product.MulMatrix(b);
+    benchmark::DoNotOptimize(product);
+  }
+  SetCounters(state, 3.0 * n * n, 2.0 * n * n * n, sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_MulMatrixOf, float)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_MulMatrixOf, double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_MulMatrixOf, long double)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_MulMatrixOf, std::complex<double>)->Apply(SquareSizes);
+
+}  // namespace
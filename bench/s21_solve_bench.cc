@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "s21_factorization.h"
+#include "s21_matrix_view.h"
+
+namespace {
+
+S21Matrix MakeMatrix(int n) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      m(i, j) = ((i * 31 + j * 17) % 19 - 9.0) / 8.0 + (i == j ? n : 0);
+    }
+  }
+
+  return (m);
+}
+
+std::vector<double> MakeVector(int n) {
+  std::vector<double> v(n);
+  for (int i = 0; i < n; ++i) {
+    v[i] = (i % 7) - 3.0;
+  }
+
+  return (v);
+}
+
+// An LU factorization of order n takes 2n^3/3 flops.
+void SetFlopsCounter(benchmark::State& state, int n) {
+  state.counters["FLOP/s"] = benchmark::Counter(
+      2.0 * n * n * n / 3.0 * state.iterations(),
+      benchmark::Counter::kIsRate);
+}
+
+// What callers did before the factorizations: invert once, then multiply
+// every right-hand side by the inverse.
+void BM_SolveWithInverse(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix inverse = MakeMatrix(n).InverseMatrix();
+  S21ConstMatrixView view = inverse.View();
+  std::vector<double> b = MakeVector(n);
+  for (auto _ : state) {
+    std::vector<double> x(n, 0.0);
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        x[i] += view.Coeff(i, j) * b[j];
+      }
+    }
+    benchmark::DoNotOptimize(x.data());
+  }
+}
+BENCHMARK(BM_SolveWithInverse)->Arg(64)->Arg(256);
+
+void BM_SolveWithLU(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21LU lu(MakeMatrix(n));
+  std::vector<double> b = MakeVector(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lu.Solve(b));
+  }
+}
+BENCHMARK(BM_SolveWithLU)->Arg(64)->Arg(256);
+
+void BM_FactorLU(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = MakeMatrix(n);
+  for (auto _ : state) {
+    S21LU lu(a);
+    benchmark::DoNotOptimize(lu.factors());
+  }
+}
+BENCHMARK(BM_FactorLU)->Arg(64)->Arg(256);
+
+// The textbook right-looking LU with partial pivoting, one rank-1 update of
+// the whole trailing matrix per column, on the same data as BM_BlockedLU.
+void BM_UnblockedLU(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = MakeMatrix(n);
+  std::vector<double> data(static_cast<std::size_t>(n) * n);
+  for (auto _ : state) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        data[i * n + j] = a(i, j);
+      }
+    }
+    for (int k = 0; k < n; ++k) {
+      int pivot = k;
+      for (int i = k + 1; i < n; ++i) {
+        if (fabs(data[i * n + k]) > fabs(data[pivot * n + k])) {
+          pivot = i;
+        }
+      }
+      for (int j = 0; j < n; ++j) {
+        std::swap(data[k * n + j], data[pivot * n + j]);
+      }
+      for (int i = k + 1; i < n; ++i) {
+        double factor = data[i * n + k] /= data[k * n + k];
+        for (int j = k + 1; j < n; ++j) {
+          data[i * n + j] -= factor * data[k * n + j];
+        }
+      }
+    }
+    benchmark::DoNotOptimize(data.data());
+  }
+  SetFlopsCounter(state, n);
+}
+BENCHMARK(BM_UnblockedLU)
+    ->RangeMultiplier(2)
+    ->Range(256, 1024)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_BlockedLU(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = MakeMatrix(n);
+  for (auto _ : state) {
+    S21LU lu(a);
+    benchmark::DoNotOptimize(lu.factors());
+  }
+  SetFlopsCounter(state, n);
+}
+BENCHMARK(BM_BlockedLU)
+    ->RangeMultiplier(2)
+    ->Range(256, 1024)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_InverseMatrix(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = MakeMatrix(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.InverseMatrix());
+  }
+}
+BENCHMARK(BM_InverseMatrix)->Arg(64)->Arg(256);
+
+}  // namespace
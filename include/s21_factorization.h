@@ -0,0 +1,96 @@
+#ifndef S21_FACTORIZATION_H_
+#define S21_FACTORIZATION_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Factorizations that keep their factors, so that a matrix is factored once
+// in O(n^3) and every later solve against it costs O(n^2) per right-hand
+// side. Solving is preferred to multiplying by InverseMatrix: it does less
+// work and is more accurate. Solve(S21Matrix) takes one right-hand side per
+// column.
+
+// PA = LU with partial pivoting, for any square matrix. From
+// kBlockedMinSize on, the factorization and the solves against a matrix run
+// in panels of kBlockSize columns with the trailing updates done by GEMM;
+// S21Matrix::Determinant and InverseMatrix use it at those sizes.
+class S21LU {
+ public:
+  static const int kBlockedMinSize;
+  static const int kBlockSize;
+
+  explicit S21LU(const S21Matrix& matrix);
+
+  int size(void) const noexcept;
+  // Unit lower triangle holds L without its diagonal, upper triangle U.
+  const S21Matrix& factors(void) const noexcept;
+  // Row i of PA is row pivots()[i] of A.
+  const std::vector<int>& pivots(void) const noexcept;
+  bool IsSingular(void) const noexcept;
+
+  std::vector<double> Solve(const std::vector<double>& b) const;
+  S21Matrix Solve(const S21Matrix& b) const;
+  double Determinant(void) const noexcept;
+  S21Matrix Inverse(void) const;
+
+ private:
+  S21Matrix lu_;
+  std::vector<int> pivots_;
+  int sign_;
+  bool singular_;
+
+  void CheckRegular(void) const;
+  void FactorPanel(const S21MatrixView& lu, int col, int width,
+                   double tolerance);
+  void FactorBlocked(const S21MatrixView& lu, int col, int width,
+                     double tolerance);
+};
+
+// A = LL^T, for symmetric positive definite matrices. Half the work of LU
+// and no pivoting; only the lower triangle of the matrix is read.
+class S21Cholesky {
+ public:
+  explicit S21Cholesky(const S21Matrix& matrix);
+
+  int size(void) const noexcept;
+  // L in the lower triangle, zeros above.
+  const S21Matrix& factor(void) const noexcept;
+
+  std::vector<double> Solve(const std::vector<double>& b) const;
+  S21Matrix Solve(const S21Matrix& b) const;
+  double Determinant(void) const noexcept;
+  S21Matrix Inverse(void) const;
+
+ private:
+  S21Matrix l_;
+};
+
+// A = QR by Householder reflections, for matrices with at least as many
+// rows as columns. Solve returns the least-squares solution when A has more
+// rows than columns; Determinant and Inverse need a square matrix.
+class S21QR {
+ public:
+  explicit S21QR(const S21Matrix& matrix);
+
+  int rows(void) const noexcept;
+  int cols(void) const noexcept;
+  // R in the upper triangle; below the diagonal of column k, the tail of the
+  // k-th reflector, whose leading element is 1.
+  const S21Matrix& factors(void) const noexcept;
+  bool IsRankDeficient(void) const noexcept;
+
+  std::vector<double> Solve(const std::vector<double>& b) const;
+  S21Matrix Solve(const S21Matrix& b) const;
+  double Determinant(void) const;
+  S21Matrix Inverse(void) const;
+
+ private:
+  S21Matrix qr_;
+  std::vector<double> tau_;
+  bool rank_deficient_;
+
+  void CheckFullRank(void) const;
+};
+
+#endif  // S21_FACTORIZATION_H_
@@ -0,0 +1,385 @@
+#ifndef S21_FIXED_MATRIX_H_
+#define S21_FIXED_MATRIX_H_
+
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+// Matrix with dimensions fixed at compile time. The elements live inside the
+// object, element-wise operations and products are unrolled over index
+// sequences, and mismatched dimensions are rejected by the compiler instead
+// of throwing. operator() is not bounds-checked.
+template <int R, int C>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "The matrix dimensions must be positive.");
+
+ public:
+  // The tolerance of EqMatrix, the same as S21Matrix::kEps but usable in
+  // constant expressions.
+  static constexpr double kEps = 1.0e-6;
+
+  constexpr S21FixedMatrix(void) noexcept : data_() {}
+
+  explicit S21FixedMatrix(const S21Matrix& other) : data_() {
+    if (other.rows() != R || other.cols() != C) {
+      throw std::invalid_argument("Different matrix dimensions.");
+    }
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        data_[i * C + j] = other(i, j);
+      }
+    }
+  }
+
+  explicit operator S21Matrix(void) const {
+    S21Matrix result(R, C);
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        result(i, j) = data_[i * C + j];
+      }
+    }
+
+    return (result);
+  }
+
+  static constexpr int rows(void) noexcept { return (R); }
+  static constexpr int cols(void) noexcept { return (C); }
+
+  constexpr bool EqMatrix(const S21FixedMatrix& other) const noexcept {
+    return (EqImpl(other, std::make_index_sequence<R * C>{}));
+  }
+
+  constexpr void SumMatrix(const S21FixedMatrix& other) noexcept {
+    SumImpl(other, std::make_index_sequence<R * C>{});
+  }
+
+  constexpr void SubMatrix(const S21FixedMatrix& other) noexcept {
+    SubImpl(other, std::make_index_sequence<R * C>{});
+  }
+
+  constexpr void MulMatrix(double num) noexcept {
+    ScaleImpl(num, std::make_index_sequence<R * C>{});
+  }
+
+  // In-place product; only a square right-hand side keeps the shape.
+  constexpr void MulMatrix(const S21FixedMatrix<C, C>& other) noexcept {
+    *this = *this * other;
+  }
+
+  constexpr S21FixedMatrix<C, R> Transpose(void) const noexcept {
+    S21FixedMatrix<C, R> result;
+    TransposeImpl(result, std::make_index_sequence<R * C>{});
+
+    return (result);
+  }
+
+  constexpr S21FixedMatrix CalcComplements(void) const noexcept {
+    static_assert(R == C, "The matrix is not square.");
+    S21FixedMatrix complements;
+    if constexpr (R == 1) {
+      complements.data_[0] = 1.0;
+    } else {
+      for (int i = 0; i < R; ++i) {
+        for (int j = 0; j < C; ++j) {
+          double sign = (i + j) % 2 ? -1.0 : 1.0;
+          complements.data_[i * C + j] = sign * Minor(i, j).Determinant();
+        }
+      }
+    }
+
+    return (complements);
+  }
+
+  // Closed forms up to 3x3, an unrolled cofactor expansion for 4x4 and LU
+  // factorization with partial pivoting above that.
+  constexpr double Determinant(void) const noexcept {
+    static_assert(R == C, "The matrix is not square.");
+    const double* a = data_;
+    double det = 0.0;
+    if constexpr (R == 1) {
+      det = a[0];
+    } else if constexpr (R == 2) {
+      det = a[0] * a[3] - a[1] * a[2];
+    } else if constexpr (R == 3) {
+      det = a[0] * (a[4] * a[8] - a[5] * a[7]) -
+            a[1] * (a[3] * a[8] - a[5] * a[6]) +
+            a[2] * (a[3] * a[7] - a[4] * a[6]);
+    } else if constexpr (R == 4) {
+      det = CofactorImpl(std::make_index_sequence<C>{});
+    } else {
+      det = LuDeterminant();
+    }
+
+    return (det);
+  }
+
+  S21FixedMatrix InverseMatrix(void) const {
+    static_assert(R == C, "The matrix is not square.");
+    S21FixedMatrix inverse;
+    if constexpr (R <= 4) {
+      double det = Determinant();
+      double tolerance = R * std::numeric_limits<double>::epsilon();
+      double scale = MaxAbs();
+      for (int i = 0; i < R; ++i) {
+        tolerance *= scale;
+      }
+      if (!(Abs(det) > tolerance)) {
+        throw std::invalid_argument(
+            "The matrix is singular and there is no inverse matrix.");
+      }
+      inverse = CalcComplements().Transpose() * (1.0 / det);
+    } else {
+      inverse = GaussJordanInverse();
+    }
+
+    return (inverse);
+  }
+
+  constexpr S21FixedMatrix operator+(
+      const S21FixedMatrix& other) const noexcept {
+    S21FixedMatrix tmp(*this);
+    tmp.SumMatrix(other);
+
+    return (tmp);
+  }
+
+  constexpr S21FixedMatrix operator-(
+      const S21FixedMatrix& other) const noexcept {
+    S21FixedMatrix tmp(*this);
+    tmp.SubMatrix(other);
+
+    return (tmp);
+  }
+
+  template <int K>
+  constexpr S21FixedMatrix<R, K> operator*(
+      const S21FixedMatrix<C, K>& other) const noexcept {
+    S21FixedMatrix<R, K> product;
+    ProductImpl(other, product, std::make_index_sequence<R * K>{});
+
+    return (product);
+  }
+
+  constexpr S21FixedMatrix operator*(double num) const noexcept {
+    S21FixedMatrix tmp(*this);
+    tmp.MulMatrix(num);
+
+    return (tmp);
+  }
+
+  constexpr bool operator==(const S21FixedMatrix& other) const noexcept {
+    return (EqMatrix(other));
+  }
+
+  constexpr S21FixedMatrix& operator+=(const S21FixedMatrix& other) noexcept {
+    SumMatrix(other);
+    return (*this);
+  }
+
+  constexpr S21FixedMatrix& operator-=(const S21FixedMatrix& other) noexcept {
+    SubMatrix(other);
+    return (*this);
+  }
+
+  constexpr S21FixedMatrix& operator*=(
+      const S21FixedMatrix<C, C>& other) noexcept {
+    MulMatrix(other);
+    return (*this);
+  }
+
+  constexpr S21FixedMatrix& operator*=(double num) noexcept {
+    MulMatrix(num);
+    return (*this);
+  }
+
+  constexpr const double& operator()(int i, int j) const noexcept {
+    return (data_[i * C + j]);
+  }
+
+  constexpr double& operator()(int i, int j) noexcept {
+    return (data_[i * C + j]);
+  }
+
+ private:
+  template <int R2, int C2>
+  friend class S21FixedMatrix;
+
+  double data_[R * C];
+
+  static constexpr double Abs(double x) noexcept { return (x < 0.0 ? -x : x); }
+
+  template <std::size_t... I>
+  constexpr bool EqImpl(const S21FixedMatrix& other,
+                        std::index_sequence<I...>) const noexcept {
+    return (((Abs(data_[I] - other.data_[I]) <= kEps) && ...));
+  }
+
+  template <std::size_t... I>
+  constexpr void SumImpl(const S21FixedMatrix& other,
+                         std::index_sequence<I...>) noexcept {
+    ((data_[I] += other.data_[I]), ...);
+  }
+
+  template <std::size_t... I>
+  constexpr void SubImpl(const S21FixedMatrix& other,
+                         std::index_sequence<I...>) noexcept {
+    ((data_[I] -= other.data_[I]), ...);
+  }
+
+  template <std::size_t... I>
+  constexpr void ScaleImpl(double num, std::index_sequence<I...>) noexcept {
+    ((data_[I] *= num), ...);
+  }
+
+  template <std::size_t... I>
+  constexpr void TransposeImpl(S21FixedMatrix<C, R>& result,
+                               std::index_sequence<I...>) const noexcept {
+    ((result.data_[(I % C) * R + I / C] = data_[I]), ...);
+  }
+
+  template <int K, std::size_t... P>
+  constexpr double Dot(const S21FixedMatrix<C, K>& other, int i, int j,
+                       std::index_sequence<P...>) const noexcept {
+    return ((0.0 + ... + (data_[i * C + P] * other.data_[P * K + j])));
+  }
+
+  template <int K, std::size_t... I>
+  constexpr void ProductImpl(const S21FixedMatrix<C, K>& other,
+                             S21FixedMatrix<R, K>& product,
+                             std::index_sequence<I...>) const noexcept {
+    ((product.data_[I] =
+          Dot(other, I / K, I % K, std::make_index_sequence<C>{})),
+     ...);
+  }
+
+  constexpr S21FixedMatrix<R - 1, C - 1> Minor(int row,
+                                               int col) const noexcept {
+    S21FixedMatrix<R - 1, C - 1> minor;
+    for (int i = 0, k = 0; i < R; ++i) {
+      if (i != row) {
+        for (int j = 0, l = 0; j < C; ++j) {
+          if (j != col) {
+            minor.data_[k * (C - 1) + l] = data_[i * C + j];
+            ++l;
+          }
+        }
+        ++k;
+      }
+    }
+
+    return (minor);
+  }
+
+  template <std::size_t... J>
+  constexpr double CofactorImpl(std::index_sequence<J...>) const noexcept {
+    return ((0.0 + ... +
+             ((J % 2 ? -1.0 : 1.0) * data_[J] * Minor(0, J).Determinant())));
+  }
+
+  constexpr double MaxAbs(void) const noexcept {
+    double max_abs = 0.0;
+    for (int i = 0; i < R * C; ++i) {
+      max_abs = Abs(data_[i]) > max_abs ? Abs(data_[i]) : max_abs;
+    }
+
+    return (max_abs);
+  }
+
+  constexpr double LuDeterminant(void) const noexcept {
+    S21FixedMatrix lu(*this);
+    double det = 1.0;
+    for (int k = 0; k < R && det != 0.0; ++k) {
+      int pivot = k;
+      for (int i = k + 1; i < R; ++i) {
+        if (Abs(lu.data_[i * C + k]) > Abs(lu.data_[pivot * C + k])) {
+          pivot = i;
+        }
+      }
+      if (lu.data_[pivot * C + k] == 0.0) {
+        det = 0.0;
+      } else {
+        if (pivot != k) {
+          lu.SwapRows(k, pivot);
+          det = -det;
+        }
+        det *= lu.data_[k * C + k];
+        for (int i = k + 1; i < R; ++i) {
+          double factor = lu.data_[i * C + k] / lu.data_[k * C + k];
+          for (int j = k + 1; j < C; ++j) {
+            lu.data_[i * C + j] -= factor * lu.data_[k * C + j];
+          }
+        }
+      }
+    }
+
+    return (det);
+  }
+
+  S21FixedMatrix GaussJordanInverse(void) const {
+    S21FixedMatrix inverse(*this);
+    int pivots[R] = {};
+    double tolerance = R * std::numeric_limits<double>::epsilon() * MaxAbs();
+
+    for (int k = 0; k < R; ++k) {
+      int pivot = k;
+      for (int i = k + 1; i < R; ++i) {
+        if (Abs(inverse(i, k)) > Abs(inverse(pivot, k))) {
+          pivot = i;
+        }
+      }
+      if (!(Abs(inverse(pivot, k)) > tolerance)) {
+        throw std::invalid_argument(
+            "The matrix is singular and there is no inverse matrix.");
+      }
+      pivots[k] = pivot;
+      inverse.SwapRows(k, pivot);
+
+      double* row_k = inverse.data_ + k * C;
+      double scale = 1.0 / row_k[k];
+      row_k[k] = 1.0;
+      for (int j = 0; j < C; ++j) {
+        row_k[j] *= scale;
+      }
+      for (int i = 0; i < R; ++i) {
+        double* row_i = inverse.data_ + i * C;
+        double factor = row_i[k];
+        if (i != k && factor != 0.0) {
+          row_i[k] = 0.0;
+          for (int j = 0; j < C; ++j) {
+            row_i[j] -= factor * row_k[j];
+          }
+        }
+      }
+    }
+
+    for (int k = R - 1; k >= 0; --k) {
+      for (int i = 0; pivots[k] != k && i < R; ++i) {
+        std::swap(inverse.data_[i * C + k], inverse.data_[i * C + pivots[k]]);
+      }
+    }
+
+    return (inverse);
+  }
+
+  constexpr void SwapRows(int a, int b) noexcept {
+    for (int j = 0; a != b && j < C; ++j) {
+      double tmp = data_[a * C + j];
+      data_[a * C + j] = data_[b * C + j];
+      data_[b * C + j] = tmp;
+    }
+  }
+};
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> operator*(
+    double num, const S21FixedMatrix<R, C>& matrix) noexcept {
+  return (matrix * num);
+}
+
+typedef S21FixedMatrix<2, 2> S21Matrix2;
+typedef S21FixedMatrix<3, 3> S21Matrix3;
+typedef S21FixedMatrix<4, 4> S21Matrix4;
+
+#endif  // S21_FIXED_MATRIX_H_
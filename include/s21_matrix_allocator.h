@@ -0,0 +1,112 @@
+#ifndef S21_MATRIX_ALLOCATOR_H_
+#define S21_MATRIX_ALLOCATOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Where S21Matrix gets the storage of matrices too large for its inline
+// buffer. Every thread has a current allocator, System() unless an
+// S21MatrixAllocatorScope says otherwise, and a matrix returns its storage
+// to the allocator it came from, wherever it is destroyed. Custom
+// allocators derive from S21MatrixAllocator and return memory aligned to
+// kAlignment bytes.
+
+struct S21MatrixAllocatorStats {
+  std::size_t allocations;
+  std::size_t deallocations;
+  std::size_t bytes_in_use;
+  std::size_t peak_bytes_in_use;
+  // Requests that reached operator new, and the bytes currently held from
+  // it, including memory cached for reuse.
+  std::size_t system_allocations;
+  std::size_t bytes_reserved;
+};
+
+class S21MatrixAllocator {
+ public:
+  static const std::size_t kAlignment;
+  static const std::size_t kPoolMaxBytes;
+
+  S21MatrixAllocator(void);
+  S21MatrixAllocator(const S21MatrixAllocator&) = delete;
+  S21MatrixAllocator& operator=(const S21MatrixAllocator&) = delete;
+  virtual ~S21MatrixAllocator(void);
+
+  virtual void* Allocate(std::size_t bytes) = 0;
+  // bytes is the size the memory was allocated with.
+  virtual void Deallocate(void* ptr, std::size_t bytes) noexcept = 0;
+
+  S21MatrixAllocatorStats stats(void) const noexcept;
+  void ResetStats(void) noexcept;
+
+  // Plain operator new and delete.
+  static S21MatrixAllocator& System(void) noexcept;
+  // Keeps freed blocks in per-thread lists by power-of-two size class and
+  // hands them out again, so a steady stream of temporaries of similar
+  // sizes stops reaching operator new. Blocks over kPoolMaxBytes are not
+  // pooled.
+  static S21MatrixAllocator& Pool(void) noexcept;
+  static S21MatrixAllocator& Current(void) noexcept;
+
+ protected:
+  void CountAllocation(std::size_t bytes) noexcept;
+  void CountDeallocation(std::size_t bytes) noexcept;
+  void CountSystemAllocation(std::size_t bytes) noexcept;
+  void CountSystemDeallocation(std::size_t bytes) noexcept;
+
+ private:
+  std::atomic<std::size_t> allocations_;
+  std::atomic<std::size_t> deallocations_;
+  std::atomic<std::size_t> bytes_in_use_;
+  std::atomic<std::size_t> peak_bytes_in_use_;
+  std::atomic<std::size_t> system_allocations_;
+  std::atomic<std::size_t> bytes_reserved_;
+};
+
+// Makes an allocator current on the calling thread for its lifetime, then
+// restores the previous one. Scopes nest.
+class S21MatrixAllocatorScope {
+ public:
+  explicit S21MatrixAllocatorScope(S21MatrixAllocator& allocator) noexcept;
+  S21MatrixAllocatorScope(const S21MatrixAllocatorScope&) = delete;
+  S21MatrixAllocatorScope& operator=(const S21MatrixAllocatorScope&) = delete;
+  ~S21MatrixAllocatorScope(void);
+
+ private:
+  S21MatrixAllocator* previous_;
+};
+
+// A bump allocator over blocks of at least block_size bytes. Memory freed in
+// the reverse order of allocation, as temporaries usually are, is reused at
+// once; other memory only once no allocation is live. Everything is
+// released when the arena is destroyed, so matrices allocated from an arena
+// must not outlive it. An arena is meant for one thread.
+//
+//   S21MatrixArena arena;
+//   S21MatrixAllocatorScope scope(arena);
+//   ... every matrix created here comes from the arena ...
+class S21MatrixArena : public S21MatrixAllocator {
+ public:
+  static const std::size_t kDefaultBlockSize;
+
+  explicit S21MatrixArena(std::size_t block_size = kDefaultBlockSize);
+  ~S21MatrixArena(void) override;
+
+  void* Allocate(std::size_t bytes) override;
+  void Deallocate(void* ptr, std::size_t bytes) noexcept override;
+
+ private:
+  struct Block {
+    char* data;
+    std::size_t size;
+  };
+
+  std::size_t block_size_;
+  std::vector<Block> blocks_;
+  std::size_t block_;
+  std::size_t offset_;
+  std::size_t live_;
+};
+
+#endif  // S21_MATRIX_ALLOCATOR_H_
@@ -0,0 +1,70 @@
+#ifndef S21_MATRIX_BATCH_H_
+#define S21_MATRIX_BATCH_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// A batch of count matrices of the same shape in one contiguous buffer. The
+// operations apply to every matrix of the batch at once and run SIMD across
+// the batch, one matrix per vector lane, so many small problems cost neither
+// an allocation nor a call each.
+//
+// kAos stores the matrices one after another, each row-major. kSoa
+// interleaves them in chunks of kLanes: the element (i, j) of the matrix b
+// is at ((b / kLanes) * rows * cols + i * cols + j) * kLanes + b % kLanes,
+// and the last chunk is padded with zero matrices. The arithmetic works on
+// the interleaved form, so kAos batches are converted on the way in and out.
+class S21MatrixBatch {
+ public:
+  enum class Layout { kAos, kSoa };
+
+  static const int kLanes;
+
+  S21MatrixBatch(int count, int rows, int cols, Layout layout = Layout::kSoa);
+
+  int count(void) const noexcept;
+  int rows(void) const noexcept;
+  int cols(void) const noexcept;
+  Layout layout(void) const noexcept;
+  double* data(void) noexcept;
+  const double* data(void) const noexcept;
+
+  S21MatrixBatch ToLayout(Layout layout) const;
+  S21Matrix Get(int index) const;
+  void Set(int index, const S21Matrix& matrix);
+
+  bool EqMatrix(const S21MatrixBatch& other) const;
+  void SumMatrix(const S21MatrixBatch& other);
+  // Multiplies every matrix by the matrix at the same index of other.
+  void MulMatrix(const S21MatrixBatch& other);
+  S21MatrixBatch Transpose(void) const;
+  std::vector<double> Determinant(void) const;
+  S21MatrixBatch InverseMatrix(void) const;
+
+  S21MatrixBatch operator+(const S21MatrixBatch& other) const;
+  S21MatrixBatch operator*(const S21MatrixBatch& other) const;
+  bool operator==(const S21MatrixBatch& other) const;
+  S21MatrixBatch& operator+=(const S21MatrixBatch& other);
+  S21MatrixBatch& operator*=(const S21MatrixBatch& other);
+  double& operator()(int index, int i, int j);
+  const double& operator()(int index, int i, int j) const;
+
+ private:
+  int count_;
+  int rows_;
+  int cols_;
+  Layout layout_;
+  std::vector<double> data_;
+
+  int chunks(void) const noexcept;
+  std::size_t Offset(int index, int i, int j) const noexcept;
+  void CheckIndex(int index, int i, int j) const;
+  static S21MatrixBatch Product(const S21MatrixBatch& lhs,
+                                const S21MatrixBatch& rhs);
+  const S21MatrixBatch& Interleaved(S21MatrixBatch& converted) const;
+  void ClearPadding(void) noexcept;
+};
+
+#endif  // S21_MATRIX_BATCH_H_
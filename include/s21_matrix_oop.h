@@ -1,57 +1,746 @@
 #ifndef S21_MATRIX_OOP_H_
 #define S21_MATRIX_OOP_H_
 
-class S21Matrix {
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Matrices whose storage, including row padding, fits in this many elements
+// are kept inside the object instead of on the heap.
+#ifndef S21_MATRIX_INLINE_CAPACITY
+#define S21_MATRIX_INLINE_CAPACITY 16
+#endif
+
+// Define S21_MATRIX_CHECK_BOUNDS, as make DEBUG=1 does, to make the
+// unchecked accessors At and operator[] check their indices like operator()
+// does. Define it for the whole program or not at all.
+
+template <typename T>
+class S21BasicMatrix;
+class S21MatrixAllocator;
+class S21MatrixView;
+class S21ConstMatrixView;
+
+// The element types the library is built for. Views, factorizations,
+// batches, sparse matrices and the file format work with S21Matrix only.
+typedef S21BasicMatrix<double> S21Matrix;
+typedef S21BasicMatrix<float> S21FloatMatrix;
+typedef S21BasicMatrix<long double> S21LongDoubleMatrix;
+typedef S21BasicMatrix<std::complex<double>> S21ComplexMatrix;
+
+// Base of every lazily evaluated matrix expression. Element-wise sums,
+// differences and scalings build a tree of expression nodes instead of
+// temporaries; the tree is evaluated in a single pass when it is assigned to
+// a matrix. Every expression names the type of its elements value_type.
+//
+// A node refers to the matrices it was built from and reads them only when
+// it is evaluated. auto sum = a + b; therefore holds a node, not a matrix:
+// it sees later changes to a and b, and dangles once they are destroyed.
+// S21Matrix sum = a + b; evaluates at once.
+template <typename E>
+class S21MatrixExpr {
+ public:
+  const E& derived(void) const noexcept {
+    return (static_cast<const E&>(*this));
+  }
+};
+
+template <typename L, typename R, typename Op>
+class S21MatrixBinaryExpr;
+template <typename E>
+class S21MatrixScaledExpr;
+
+// Walks the rows of a matrix; dereferencing gives a pointer to the first
+// element of the row. T is the element type, possibly const. The pointer is
+// a value, not a reference to one, so the standard library may only treat
+// the iterator as an input iterator, although it supports the arithmetic
+// and comparisons of a random-access one.
+template <typename T>
+class S21MatrixRowIterator {
+ public:
+  typedef std::input_iterator_tag iterator_category;
+  typedef T* value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef T* const* pointer;
+  typedef T* reference;
+
+  S21MatrixRowIterator(void) noexcept : row_(nullptr), stride_(0) {}
+  S21MatrixRowIterator(T* row, std::ptrdiff_t stride) noexcept
+      : row_(row), stride_(stride) {}
+
+  T* operator*(void) const noexcept { return (row_); }
+  T* operator[](difference_type n) const noexcept {
+    return (row_ + n * stride_);
+  }
+  S21MatrixRowIterator& operator++(void) noexcept {
+    row_ += stride_;
+    return (*this);
+  }
+  S21MatrixRowIterator operator++(int) noexcept {
+    S21MatrixRowIterator tmp(*this);
+    row_ += stride_;
+    return (tmp);
+  }
+  S21MatrixRowIterator& operator--(void) noexcept {
+    row_ -= stride_;
+    return (*this);
+  }
+  S21MatrixRowIterator operator--(int) noexcept {
+    S21MatrixRowIterator tmp(*this);
+    row_ -= stride_;
+    return (tmp);
+  }
+  S21MatrixRowIterator& operator+=(difference_type n) noexcept {
+    row_ += n * stride_;
+    return (*this);
+  }
+  S21MatrixRowIterator& operator-=(difference_type n) noexcept {
+    row_ -= n * stride_;
+    return (*this);
+  }
+  S21MatrixRowIterator operator+(difference_type n) const noexcept {
+    return (S21MatrixRowIterator(row_ + n * stride_, stride_));
+  }
+  S21MatrixRowIterator operator-(difference_type n) const noexcept {
+    return (S21MatrixRowIterator(row_ - n * stride_, stride_));
+  }
+  // The rows of a moved-from matrix have no stride and are all the same.
+  difference_type operator-(const S21MatrixRowIterator& other) const noexcept {
+    return (stride_ == 0 ? 0 : (row_ - other.row_) / stride_);
+  }
+  bool operator==(const S21MatrixRowIterator& other) const noexcept {
+    return (row_ == other.row_);
+  }
+  bool operator!=(const S21MatrixRowIterator& other) const noexcept {
+    return (row_ != other.row_);
+  }
+  bool operator<(const S21MatrixRowIterator& other) const noexcept {
+    return (row_ < other.row_);
+  }
+  bool operator>(const S21MatrixRowIterator& other) const noexcept {
+    return (row_ > other.row_);
+  }
+  bool operator<=(const S21MatrixRowIterator& other) const noexcept {
+    return (row_ <= other.row_);
+  }
+  bool operator>=(const S21MatrixRowIterator& other) const noexcept {
+    return (row_ >= other.row_);
+  }
+  friend S21MatrixRowIterator operator+(difference_type n,
+                                        const S21MatrixRowIterator& it) {
+    return (it + n);
+  }
+
+ private:
+  T* row_;
+  std::ptrdiff_t stride_;
+};
+
+// The rows of a matrix as a range, for range-based for loops.
+template <typename T>
+class S21MatrixRows {
+ public:
+  typedef S21MatrixRowIterator<T> iterator;
+
+  S21MatrixRows(T* data, int rows, std::ptrdiff_t stride) noexcept
+      : data_(data), rows_(rows), stride_(stride) {}
+
+  iterator begin(void) const noexcept { return (iterator(data_, stride_)); }
+  iterator end(void) const noexcept {
+    return (iterator(data_ + rows_ * stride_, stride_));
+  }
+  int size(void) const noexcept { return (rows_); }
+
+ private:
+  T* data_;
+  int rows_;
+  std::ptrdiff_t stride_;
+};
+
+// A dense row-major matrix of elements of type T: float, double,
+// long double or std::complex<double>. The library is compiled for those
+// four; S21Matrix is the double one. All four have the constructors,
+// Borrow and the allocators, element and row access, the arithmetic and
+// its expressions, EqMatrix, Transpose, Determinant, ExactDeterminant,
+// CalcComplements and InverseMatrix. Only double has View, Save and Load,
+// which are deleted for the others, and only S21Matrix is accepted by the
+// factorizations, batches, sparse and fixed-size matrices and out-of-core
+// products. For the others MulMatrix runs kStrassen as kBlocked.
+template <typename T>
+class S21BasicMatrix : public S21MatrixExpr<S21BasicMatrix<T>> {
  public:
+  typedef T value_type;
+
+  // The absolute tolerance of EqMatrix: 1e-6, or 1024 units in the last
+  // place of 1 when that is larger, about 1.2e-4 for float. Except for
+  // double, EqMatrix also accepts differences up to 1024 units in the last
+  // place of the smaller of the two elements, so large floats compare by
+  // their leading digits.
   static const double kEps;
   static const int kDefaultRows;
   static const int kDefaultCols;
+  // The largest order ExactDeterminant accepts.
+  static const int kExactDeterminantMaxSize;
+
+  // Where the elements live. Heap storage comes from the allocator current
+  // on the constructing thread, see s21_matrix_allocator.h. Borrowed storage
+  // belongs to the caller and is never released by the matrix; adopted
+  // storage is released with the deleter passed to Adopt.
+  enum class Storage { kInline, kHeap, kBorrowed, kAdopted };
+  typedef std::function<void(T*)> Deleter;
+  // How MulMatrix multiplies two matrices. kStrassen uses Strassen-Winograd
+  // recursion on products of order 256 and up, which does fewer flops but
+  // rounds differently: its error bound grows like n^4.17 instead of n.
+  // Smaller products, and products of other element types than double, are
+  // computed like with kBlocked.
+  enum class Multiplication { kBlocked, kStrassen };
 
-  S21Matrix(void);
-  explicit S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix& other);
-  S21Matrix(S21Matrix&& other) noexcept;
-  S21Matrix& operator=(const S21Matrix& other);
-  S21Matrix& operator=(S21Matrix&& other) noexcept;
+  S21BasicMatrix(void);
+  explicit S21BasicMatrix(int rows, int cols);
+  S21BasicMatrix(const S21BasicMatrix& other);
+  S21BasicMatrix(S21BasicMatrix&& other) noexcept;
+  S21BasicMatrix& operator=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator=(S21BasicMatrix&& other) noexcept;
+  template <typename E>
+  S21BasicMatrix(const S21MatrixExpr<E>& expr);
+  template <typename E>
+  S21BasicMatrix& operator=(const S21MatrixExpr<E>& expr);
 
-  ~S21Matrix(void);
+  // Wrap an existing row-major buffer, whose rows are stride elements apart,
+  // without copying it. Writes through the matrix land in the buffer,
+  // including the results of MulMatrix and of assignments, until an
+  // operation that changes the dimensions moves the matrix to storage of
+  // its own. Copies are always owned. If Adopt throws, the caller keeps
+  // ownership of the buffer.
+  static S21BasicMatrix Borrow(T* data, int rows, int cols, int stride);
+  static S21BasicMatrix Adopt(T* data, int rows, int cols, int stride,
+                              Deleter deleter);
+
+  // Binary file format: a 64-byte header followed by the rows, each padded
+  // like in memory, in native byte order. Save streams the rows in chunks
+  // to a new file next to path and renames it over path once it is synced,
+  // so matrices loaded from path keep their elements; a moved-from matrix
+  // has no rows and throws std::invalid_argument.
+  // Load maps the file into memory instead of reading it, so the elements
+  // are paged in on first access; writes to the loaded matrix are private to
+  // the process. Verifying the checksum reads the whole file.
+  void Save(const std::string& path) const;
+  static S21BasicMatrix Load(const std::string& path, bool verify = false);
+
+  ~S21BasicMatrix(void);
 
   int rows(void) const noexcept;
   int cols(void) const noexcept;
+  Storage storage(void) const noexcept;
   void set_rows(int rows);
   void set_cols(int cols);
-  bool EqMatrix(const S21Matrix& other) const noexcept;
-  void SumMatrix(const S21Matrix& other);
-  void SubMatrix(const S21Matrix& other);
-  void MulMatrix(double num) noexcept;
-  void MulMatrix(const S21Matrix& other);
-  S21Matrix Transpose(void) const;
-  S21Matrix CalcComplements(void) const;
-  double Determinant(void) const;
-  S21Matrix InverseMatrix(void) const;
-
-  S21Matrix operator+(const S21Matrix& other) const;
-  S21Matrix operator-(const S21Matrix& other) const;
-  S21Matrix operator*(const S21Matrix& other) const;
-  S21Matrix operator*(double num) const;
-  bool operator==(const S21Matrix& other) const noexcept;
-  S21Matrix& operator+=(const S21Matrix& other);
-  S21Matrix& operator-=(const S21Matrix& other);
-  S21Matrix& operator*=(const S21Matrix& other);
-  S21Matrix& operator*=(double num) noexcept;
-  const double& operator()(int i, int j) const;
-  double& operator()(int i, int j);
+  static int thread_count(void) noexcept;
+  static void set_thread_count(int count);
+  // Views of the whole matrix; see s21_matrix_view.h.
+  S21MatrixView View(void) noexcept;
+  S21ConstMatrixView View(void) const noexcept;
+  bool EqMatrix(const S21BasicMatrix& other) const noexcept;
+  void SumMatrix(const S21BasicMatrix& other);
+  void SubMatrix(const S21BasicMatrix& other);
+  void MulMatrix(T num) noexcept;
+  void MulMatrix(const S21BasicMatrix& other);
+  void MulMatrix(const S21BasicMatrix& other, Multiplication multiplication);
+  S21BasicMatrix Transpose(void) const;
+  // O(n^3) through the inverse, except for singular matrices above order 6,
+  // which take one determinant per minor, O(n^5).
+  S21BasicMatrix CalcComplements(void) const;
+  T Determinant(void) const;
+  // Cofactor expansion along the first row, which keeps integer-valued
+  // matrices exact but costs O(n!): it throws std::invalid_argument above
+  // kExactDeterminantMaxSize. Determinant is O(n^3).
+  T ExactDeterminant(void) const;
+  S21BasicMatrix InverseMatrix(void) const;
+
+  // Friends found by argument-dependent lookup, so that expressions convert
+  // to the matrix type.
+  friend S21BasicMatrix operator*(const S21BasicMatrix& lhs,
+                                  const S21BasicMatrix& rhs) {
+    return (Product(lhs, rhs));
+  }
+  friend bool operator==(const S21BasicMatrix& lhs,
+                         const S21BasicMatrix& rhs) noexcept {
+    return (lhs.EqMatrix(rhs));
+  }
+  S21BasicMatrix& operator+=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator-=(const S21BasicMatrix& other);
+  template <typename E>
+  S21BasicMatrix& operator+=(const S21MatrixExpr<E>& expr);
+  template <typename E>
+  S21BasicMatrix& operator-=(const S21MatrixExpr<E>& expr);
+  S21BasicMatrix& operator*=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(T num) noexcept;
+  const T& operator()(int i, int j) const;
+  T& operator()(int i, int j);
+
+  // Unchecked access for inner loops, unless S21_MATRIX_CHECK_BOUNDS is
+  // defined. operator[] returns a pointer to row i, so m[i][j] is At(i, j).
+  // Rows are stride() elements apart, which can be more than cols(), and
+  // data() points to the first one. Changing the dimensions invalidates
+  // the pointers.
+  T& At(int i, int j);
+  const T& At(int i, int j) const;
+  T* operator[](int i);
+  const T* operator[](int i) const;
+  T* data(void) noexcept { return (data_); }
+  const T* data(void) const noexcept { return (data_); }
+  int stride(void) const noexcept { return (stride_); }
+  // for (T* row : m.Rows()) { ... row[j] ... }
+  S21MatrixRows<T> Rows(void) noexcept {
+    return (S21MatrixRows<T>(data_, rows_, stride_));
+  }
+  S21MatrixRows<const T> Rows(void) const noexcept {
+    return (S21MatrixRows<const T>(data_, rows_, stride_));
+  }
 
  private:
+  template <typename L, typename R, typename Op>
+  friend class S21MatrixBinaryExpr;
+  template <typename E>
+  friend class S21MatrixScaledExpr;
+
+  static constexpr std::size_t kAlignment = 64;
+  static constexpr int kInlineCapacity = S21_MATRIX_INLINE_CAPACITY;
+  static_assert(kInlineCapacity > 0, "The inline capacity must be positive.");
+  static const int kStrideAlignment;
+  static const int kCofactorMaxSize;
+  static const int kParallelMinSize;
+  static const int kParallelGrain;
+
   int rows_;
   int cols_;
-  double** matrix_;
+  int stride_;
+  Storage storage_;
+  T* data_;
+  Deleter* deleter_;
+  S21MatrixAllocator* allocator_;
+  alignas(kAlignment) T inline_[kInlineCapacity];
 
+  S21BasicMatrix(T* data, int rows, int cols, int stride, Storage storage,
+                 Deleter* deleter) noexcept;
+  static void CheckExternal(const T* data, int rows, int cols, int stride);
+  static int PaddedStride(int cols) noexcept;
+  void CheckRow(int i) const;
+  void CheckCol(int j) const;
   void AllocateMatrix(int rows, int cols);
   void ResetMatrix(void) noexcept;
-  void CopyMatrix(const S21Matrix& other) noexcept;
-  void SwapMatrix(S21Matrix& other) noexcept;
-  S21Matrix Minor(int row, int col) const;
+  void CopyMatrix(const S21BasicMatrix& other) noexcept;
+  void SwapMatrix(S21BasicMatrix& other) noexcept;
+  void TakeMatrix(S21BasicMatrix& other) noexcept;
+  T* Row(int i) noexcept;
+  const T* Row(int i) const noexcept;
+  bool IsContiguous(void) const noexcept;
+  bool IsInline(void) const noexcept;
+  std::size_t capacity(void) const noexcept;
+  S21BasicMatrix Minor(int row, int col) const;
+  T LuDeterminant(void) const;
+  bool Invert(S21BasicMatrix& inverse, T& det) const;
+  std::size_t size(void) const noexcept;
+  static S21BasicMatrix Product(
+      const S21BasicMatrix& lhs, const S21BasicMatrix& rhs,
+      Multiplication multiplication = Multiplication::kBlocked);
+
+  T Coeff(int i, int j) const noexcept {
+    return (data_[static_cast<std::ptrdiff_t>(i) * stride_ + j]);
+  }
+  template <typename E>
+  void Assign(const E& expr) noexcept;
+  template <typename Op>
+  void Assign(const S21MatrixBinaryExpr<S21BasicMatrix, S21BasicMatrix, Op>&
+                  expr) noexcept;
+  template <typename E, typename Op>
+  void Evaluate(const E& expr, Op op) noexcept;
+};
+
+template <typename T>
+inline T& S21BasicMatrix<T>::At(int i, int j) {
+#ifdef S21_MATRIX_CHECK_BOUNDS
+  CheckRow(i);
+  CheckCol(j);
+#endif
+  return (data_[static_cast<std::ptrdiff_t>(i) * stride_ + j]);
+}
+
+template <typename T>
+inline const T& S21BasicMatrix<T>::At(int i, int j) const {
+#ifdef S21_MATRIX_CHECK_BOUNDS
+  CheckRow(i);
+  CheckCol(j);
+#endif
+  return (data_[static_cast<std::ptrdiff_t>(i) * stride_ + j]);
+}
+
+template <typename T>
+inline T* S21BasicMatrix<T>::operator[](int i) {
+#ifdef S21_MATRIX_CHECK_BOUNDS
+  CheckRow(i);
+#endif
+  return (data_ + static_cast<std::ptrdiff_t>(i) * stride_);
+}
+
+template <typename T>
+inline const T* S21BasicMatrix<T>::operator[](int i) const {
+#ifdef S21_MATRIX_CHECK_BOUNDS
+  CheckRow(i);
+#endif
+  return (data_ + static_cast<std::ptrdiff_t>(i) * stride_);
+}
+
+// Expression nodes keep matrices by reference and nested nodes by value, so
+// an expression must be evaluated before the matrices it names go away.
+template <typename E>
+struct S21MatrixOperand {
+  typedef E type;
+};
+
+template <typename T>
+struct S21MatrixOperand<S21BasicMatrix<T>> {
+  typedef const S21BasicMatrix<T>& type;
+};
+
+// Members that evaluate an expression node into a matrix and call the
+// matrix member of the same name, so that (a + b).Transpose() and
+// (a - b)(0, 0) work as they do on a matrix. operator() only evaluates the
+// element it returns.
+template <typename E>
+class S21MatrixNode : public S21MatrixExpr<E> {
+ public:
+  auto Eval(void) const {
+    return (S21BasicMatrix<typename E::value_type>(this->derived()));
+  }
+  auto operator()(int i, int j) const {
+    const E& expr = this->derived();
+    if (i < 0 || i >= expr.rows()) {
+      throw std::out_of_range("Index outside the range of rows.");
+    }
+    if (j < 0 || j >= expr.cols()) {
+      throw std::out_of_range("Index outside the range of columns.");
+    }
+    return (expr.Coeff(i, j));
+  }
+  template <typename M>
+  bool EqMatrix(const M& other) const {
+    return (Eval().EqMatrix(other));
+  }
+  auto Transpose(void) const { return (Eval().Transpose()); }
+  auto CalcComplements(void) const { return (Eval().CalcComplements()); }
+  auto Determinant(void) const { return (Eval().Determinant()); }
+  auto InverseMatrix(void) const { return (Eval().InverseMatrix()); }
+};
+
+// Apply combines two elements, Update a whole matrix in place.
+struct S21MatrixPlus {
+  template <typename T>
+  static T Apply(const T& lhs, const T& rhs) noexcept {
+    return (lhs + rhs);
+  }
+  template <typename M>
+  static void Update(M& lhs, const M& rhs) {
+    lhs.SumMatrix(rhs);
+  }
 };
 
+struct S21MatrixMinus {
+  template <typename T>
+  static T Apply(const T& lhs, const T& rhs) noexcept {
+    return (lhs - rhs);
+  }
+  template <typename M>
+  static void Update(M& lhs, const M& rhs) {
+    lhs.SubMatrix(rhs);
+  }
+};
+
+template <typename L, typename R, typename Op>
+class S21MatrixBinaryExpr
+    : public S21MatrixNode<S21MatrixBinaryExpr<L, R, Op>> {
+ public:
+  typedef typename L::value_type value_type;
+  static_assert(std::is_same<value_type, typename R::value_type>::value,
+                "The operands must have the same element type.");
+
+  S21MatrixBinaryExpr(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols()) {
+      throw std::invalid_argument("Different matrix dimensions.");
+    }
+  }
+
+  int rows(void) const noexcept { return (lhs_.rows()); }
+  int cols(void) const noexcept { return (lhs_.cols()); }
+  const L& lhs(void) const noexcept { return (lhs_); }
+  const R& rhs(void) const noexcept { return (rhs_); }
+  value_type Coeff(int i, int j) const noexcept {
+    return (Op::Apply(lhs_.Coeff(i, j), rhs_.Coeff(i, j)));
+  }
+
+ private:
+  typename S21MatrixOperand<L>::type lhs_;
+  typename S21MatrixOperand<R>::type rhs_;
+};
+
+template <typename E>
+class S21MatrixScaledExpr : public S21MatrixNode<S21MatrixScaledExpr<E>> {
+ public:
+  typedef typename E::value_type value_type;
+
+  S21MatrixScaledExpr(const E& expr, value_type num)
+      : expr_(expr), num_(num) {}
+
+  int rows(void) const noexcept { return (expr_.rows()); }
+  int cols(void) const noexcept { return (expr_.cols()); }
+  value_type Coeff(int i, int j) const noexcept {
+    return (expr_.Coeff(i, j) * num_);
+  }
+
+ private:
+  typename S21MatrixOperand<E>::type expr_;
+  value_type num_;
+};
+
+template <typename L, typename R>
+S21MatrixBinaryExpr<L, R, S21MatrixPlus> operator+(
+    const S21MatrixExpr<L>& lhs, const S21MatrixExpr<R>& rhs) {
+  return (S21MatrixBinaryExpr<L, R, S21MatrixPlus>(lhs.derived(),
+                                                   rhs.derived()));
+}
+
+template <typename L, typename R>
+S21MatrixBinaryExpr<L, R, S21MatrixMinus> operator-(
+    const S21MatrixExpr<L>& lhs, const S21MatrixExpr<R>& rhs) {
+  return (S21MatrixBinaryExpr<L, R, S21MatrixMinus>(lhs.derived(),
+                                                    rhs.derived()));
+}
+
+// The number is converted to the element type of the expression, so that
+// m * 2 scales a float matrix too.
+template <typename E>
+S21MatrixScaledExpr<E> operator*(const S21MatrixExpr<E>& expr,
+                                 typename E::value_type num) {
+  return (S21MatrixScaledExpr<E>(expr.derived(), num));
+}
+
+template <typename E>
+S21MatrixScaledExpr<E> operator*(typename E::value_type num,
+                                 const S21MatrixExpr<E>& expr) {
+  return (S21MatrixScaledExpr<E>(expr.derived(), num));
+}
+
+template <typename M>
+struct S21IsBasicMatrix : std::false_type {};
+
+template <typename T>
+struct S21IsBasicMatrix<S21BasicMatrix<T>> : std::true_type {};
+
+// Overloads for expiring matrices evaluate in place in the operand's storage
+// and return it, so they do not allocate. They are templates only so that
+// they bind to rvalue matrices alone and never compete with the expression
+// operators above through a conversion.
+template <typename M>
+using S21IfExpiring = std::enable_if_t<S21IsBasicMatrix<M>::value>;
+
+template <typename M, typename E, typename = S21IfExpiring<M>>
+M operator+(M&& lhs, const S21MatrixExpr<E>& rhs) {
+  lhs += rhs.derived();
+  return (std::move(lhs));
+}
+
+template <typename E, typename M, typename = S21IfExpiring<M>>
+M operator+(const S21MatrixExpr<E>& lhs, M&& rhs) {
+  rhs += lhs.derived();
+  return (std::move(rhs));
+}
+
+template <typename M, typename N, typename = S21IfExpiring<M>,
+          typename = S21IfExpiring<N>>
+M operator+(M&& lhs, N&& rhs) {
+  lhs += rhs;
+  return (std::move(lhs));
+}
+
+template <typename M, typename E, typename = S21IfExpiring<M>>
+M operator-(M&& lhs, const S21MatrixExpr<E>& rhs) {
+  lhs -= rhs.derived();
+  return (std::move(lhs));
+}
+
+template <typename E, typename M, typename = S21IfExpiring<M>>
+M operator-(const S21MatrixExpr<E>& lhs, M&& rhs) {
+  const M& subtrahend = rhs;
+  rhs = lhs.derived() - subtrahend;
+  return (std::move(rhs));
+}
+
+template <typename M, typename N, typename = S21IfExpiring<M>,
+          typename = S21IfExpiring<N>>
+M operator-(M&& lhs, N&& rhs) {
+  lhs -= rhs;
+  return (std::move(lhs));
+}
+
+template <typename M, typename = S21IfExpiring<M>>
+M operator*(M&& matrix, typename M::value_type num) noexcept {
+  matrix *= num;
+  return (std::move(matrix));
+}
+
+template <typename M, typename = S21IfExpiring<M>>
+M operator*(typename M::value_type num, M&& matrix) noexcept {
+  matrix *= num;
+  return (std::move(matrix));
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>::S21BasicMatrix(const S21MatrixExpr<E>& expr)
+    : rows_(expr.derived().rows()), cols_(expr.derived().cols()) {
+  AllocateMatrix(rows_, cols_);
+  Assign(expr.derived());
+}
+
+// Every element of the result depends only on the same element of the
+// operands, so evaluating in place is safe even when this matrix is one of
+// them.
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21MatrixExpr<E>& expr) {
+  const E& e = expr.derived();
+  if (rows_ != e.rows() || cols_ != e.cols()) {
+    S21BasicMatrix(e).SwapMatrix(*this);
+  } else {
+    Assign(e);
+  }
+
+  return (*this);
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(
+    const S21MatrixExpr<E>& expr) {
+  const E& e = expr.derived();
+  if (rows_ != e.rows() || cols_ != e.cols()) {
+    throw std::invalid_argument("Different matrix dimensions.");
+  }
+  Evaluate(e, [](T& element, const T& value) { return (element + value); });
+
+  return (*this);
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(
+    const S21MatrixExpr<E>& expr) {
+  const E& e = expr.derived();
+  if (rows_ != e.rows() || cols_ != e.cols()) {
+    throw std::invalid_argument("Different matrix dimensions.");
+  }
+  Evaluate(e, [](T& element, const T& value) { return (element - value); });
+
+  return (*this);
+}
+
+template <typename T>
+template <typename E>
+void S21BasicMatrix<T>::Assign(const E& expr) noexcept {
+  Evaluate(expr, [](T&, const T& value) { return (value); });
+}
+
+// The sum or difference of two matrices copies the first and runs the
+// vectorized SumMatrix or SubMatrix. When only the second is this matrix,
+// which the copy would overwrite, the first is added to it, negated for a
+// difference, which rounds the same.
+template <typename T>
+template <typename Op>
+void S21BasicMatrix<T>::Assign(
+    const S21MatrixBinaryExpr<S21BasicMatrix, S21BasicMatrix, Op>&
+        expr) noexcept {
+  if (&expr.rhs() != this) {
+    if (&expr.lhs() != this) {
+      CopyMatrix(expr.lhs());
+    }
+    Op::Update(*this, expr.rhs());
+  } else if (&expr.lhs() == this) {
+    Evaluate(expr, [](T&, const T& value) { return (value); });
+  } else {
+    if (std::is_same<Op, S21MatrixMinus>::value) {
+      MulMatrix(T(-1));
+    }
+    SumMatrix(expr.lhs());
+  }
+}
+
+template <typename T>
+template <typename E, typename Op>
+void S21BasicMatrix<T>::Evaluate(const E& expr, Op op) noexcept {
+  for (int i = 0; i < rows_; ++i) {
+    T* row = data_ + static_cast<std::ptrdiff_t>(i) * stride_;
+    for (int j = 0; j < cols_; ++j) {
+      row[j] = op(row[j], expr.Coeff(i, j));
+    }
+  }
+}
+
+// Views and the file format exist for double elements only; for the other
+// element types the library is built for they are deleted, so that calls
+// fail to compile rather than to link.
+template <>
+S21MatrixView S21BasicMatrix<double>::View(void) noexcept;
+template <>
+S21ConstMatrixView S21BasicMatrix<double>::View(void) const noexcept;
+template <>
+void S21BasicMatrix<double>::Save(const std::string& path) const;
+template <>
+S21BasicMatrix<double> S21BasicMatrix<double>::Load(const std::string& path,
+                                                    bool verify);
+
+template <>
+S21MatrixView S21BasicMatrix<float>::View(void) noexcept = delete;
+template <>
+S21ConstMatrixView S21BasicMatrix<float>::View(void) const noexcept = delete;
+template <>
+void S21BasicMatrix<float>::Save(const std::string& path) const = delete;
+template <>
+S21BasicMatrix<float> S21BasicMatrix<float>::Load(const std::string& path,
+                                                  bool verify) = delete;
+
+template <>
+S21MatrixView S21BasicMatrix<long double>::View(void) noexcept = delete;
+template <>
+S21ConstMatrixView S21BasicMatrix<long double>::View(void) const noexcept =
+    delete;
+template <>
+void S21BasicMatrix<long double>::Save(const std::string& path) const =
+    delete;
+template <>
+S21BasicMatrix<long double> S21BasicMatrix<long double>::Load(
+    const std::string& path, bool verify) = delete;
+
+template <>
+S21MatrixView S21BasicMatrix<std::complex<double>>::View(void) noexcept =
+    delete;
+template <>
+S21ConstMatrixView S21BasicMatrix<std::complex<double>>::View(
+    void) const noexcept = delete;
+template <>
+void S21BasicMatrix<std::complex<double>>::Save(
+    const std::string& path) const = delete;
+template <>
+S21BasicMatrix<std::complex<double>>
+S21BasicMatrix<std::complex<double>>::Load(const std::string& path,
+                                           bool verify) = delete;
+
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+extern template class S21BasicMatrix<std::complex<double>>;
+
 #endif  // S21_MATRIX_OOP_H_
@@ -0,0 +1,78 @@
+#ifndef S21_MATRIX_STATS_H_
+#define S21_MATRIX_STATS_H_
+
+#include <cstdint>
+#include <string>
+
+// Counters of the calls to each S21Matrix operation, collected only when the
+// library is built with S21_MATRIX_INSTRUMENT defined (make INSTRUMENT=1).
+// Otherwise the hooks compile to nothing and every snapshot is zero.
+//
+// An operation counts the elements of the operands it reads, the matrix
+// storage allocated while it runs and its latency, on whichever thread it
+// is called. Operations that call others, like InverseMatrix copying its
+// operand, are counted in both. Products are counted whether they come from
+// MulMatrix or operator*, and a + b or a - b of two matrices is counted as
+// SumMatrix or SubMatrix, with the copy of a. Longer expressions, such as
+// a + b - c or a * 2.0 + b, and compound assignments of an expression are
+// evaluated inline in one pass and are not counted.
+//
+//   S21MatrixStats::Reset();
+//   ... run the workload ...
+//   std::cout << S21MatrixStats::Snapshot().ToPrometheus();
+class S21MatrixStats {
+ public:
+  enum class Operation {
+    kAllocateMatrix,
+    kCopyMatrix,
+    kEqMatrix,
+    kSumMatrix,
+    kSubMatrix,
+    kMulNumber,
+    kMulMatrix,
+    kTranspose,
+    kCalcComplements,
+    kDeterminant,
+    kInverseMatrix,
+    kCount
+  };
+
+  static constexpr int kOperations = static_cast<int>(Operation::kCount);
+  // Latencies are counted in buckets bounded above by kLatencyBoundsNs,
+  // powers of ten from 100 ns to 10 s, and a last unbounded bucket.
+  static constexpr int kLatencyBuckets = 10;
+  static const std::uint64_t kLatencyBoundsNs[kLatencyBuckets - 1];
+
+  struct Counters {
+    std::uint64_t calls;
+    std::uint64_t elements;
+    std::uint64_t allocations;
+    std::uint64_t bytes_allocated;
+    std::uint64_t total_ns;
+    std::uint64_t latency_buckets[kLatencyBuckets];
+  };
+
+  // Whether the library was built with the instrumentation.
+  static bool enabled(void) noexcept;
+  // The counters are read one at a time, so a snapshot taken while other
+  // threads run operations need not be consistent across operations.
+  static S21MatrixStats Snapshot(void) noexcept;
+  static void Reset(void) noexcept;
+  // snake_case, as used in the JSON keys and the Prometheus labels.
+  static const char* Name(Operation operation) noexcept;
+
+  const Counters& operator[](Operation operation) const;
+
+  std::string ToJson(void) const;
+  // The Prometheus text exposition format: counters of calls, elements,
+  // allocations and bytes, and a latency histogram in seconds, each labelled
+  // by operation.
+  std::string ToPrometheus(void) const;
+
+ private:
+  Counters counters_[kOperations];
+
+  S21MatrixStats(void) noexcept;
+};
+
+#endif  // S21_MATRIX_STATS_H_
@@ -0,0 +1,114 @@
+#ifndef S21_MATRIX_VIEW_H_
+#define S21_MATRIX_VIEW_H_
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "s21_matrix_oop.h"
+
+// Non-owning rectangular windows into matrix storage. A view is a pointer to
+// its first element, its extents and the distance in elements between
+// consecutive rows and columns, so blocks, single rows and columns, and
+// transposes of a matrix are all views of the same buffer and are created
+// without copying. Views take part in expressions like matrices do, and
+// S21Matrix can be constructed from one to materialize it.
+//
+// A view does not keep its storage alive. The destination of the in-place
+// operations must not overlap their operands, except for being the very
+// same view.
+
+class S21ConstMatrixView : public S21MatrixExpr<S21ConstMatrixView> {
+ public:
+  typedef double value_type;
+
+  S21ConstMatrixView(const double* data, int rows, int cols,
+                     std::ptrdiff_t row_stride, std::ptrdiff_t col_stride = 1);
+  S21ConstMatrixView(const S21Matrix& matrix) noexcept;
+
+  int rows(void) const noexcept { return (rows_); }
+  int cols(void) const noexcept { return (cols_); }
+  std::ptrdiff_t row_stride(void) const noexcept { return (row_stride_); }
+  std::ptrdiff_t col_stride(void) const noexcept { return (col_stride_); }
+  const double* data(void) const noexcept { return (data_); }
+  // True when each row, or the whole view, is one run of adjacent elements.
+  bool HasContiguousRows(void) const noexcept { return (col_stride_ == 1); }
+  bool IsContiguous(void) const noexcept;
+
+  S21ConstMatrixView Block(int row, int col, int rows, int cols) const;
+  S21ConstMatrixView Row(int i) const;
+  S21ConstMatrixView Col(int j) const;
+  S21ConstMatrixView Transposed(void) const noexcept;
+  bool EqMatrix(const S21ConstMatrixView& other) const noexcept;
+
+  const double& operator()(int i, int j) const;
+  // Unchecked element access used by expression evaluation.
+  double Coeff(int i, int j) const noexcept {
+    return (data_[i * row_stride_ + j * col_stride_]);
+  }
+
+ protected:
+  const double* data_;
+  int rows_;
+  int cols_;
+  std::ptrdiff_t row_stride_;
+  std::ptrdiff_t col_stride_;
+
+  void CheckBlock(int row, int col, int rows, int cols) const;
+};
+
+// A view through which the elements can also be written. It converts to the
+// read-only view without a user-defined conversion, so it is accepted
+// everywhere a S21ConstMatrixView is.
+class S21MatrixView : public S21ConstMatrixView {
+ public:
+  S21MatrixView(double* data, int rows, int cols, std::ptrdiff_t row_stride,
+                std::ptrdiff_t col_stride = 1);
+  S21MatrixView(S21Matrix& matrix) noexcept;
+
+  double* data(void) const noexcept { return (const_cast<double*>(data_)); }
+
+  S21MatrixView Block(int row, int col, int rows, int cols) const;
+  S21MatrixView Row(int i) const;
+  S21MatrixView Col(int j) const;
+  S21MatrixView Transposed(void) const noexcept;
+
+  void SumMatrix(const S21ConstMatrixView& other) const;
+  void SubMatrix(const S21ConstMatrixView& other) const;
+  void MulMatrix(double num) const noexcept;
+  // this += lhs * rhs, accumulated directly into the viewed storage.
+  void AddProduct(const S21ConstMatrixView& lhs,
+                  const S21ConstMatrixView& rhs) const;
+  template <typename E>
+  void Assign(const S21MatrixExpr<E>& expr) const;
+
+  double& operator()(int i, int j) const;
+
+ private:
+  explicit S21MatrixView(const S21ConstMatrixView& view) noexcept;
+};
+
+// Views may have no rows or columns but matrices may not, so a product
+// without rows or columns throws std::invalid_argument. A product over an
+// empty inner dimension is a zero matrix.
+S21Matrix operator*(const S21ConstMatrixView& lhs,
+                    const S21ConstMatrixView& rhs);
+S21Matrix operator*(const S21Matrix& lhs, const S21ConstMatrixView& rhs);
+S21Matrix operator*(const S21ConstMatrixView& lhs, const S21Matrix& rhs);
+
+// Elements are evaluated one at a time, so the expression may read the
+// destination itself at the same position.
+template <typename E>
+void S21MatrixView::Assign(const S21MatrixExpr<E>& expr) const {
+  const E& e = expr.derived();
+  if (rows_ != e.rows() || cols_ != e.cols()) {
+    throw std::invalid_argument("Different matrix dimensions.");
+  }
+  double* data = this->data();
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      data[i * row_stride_ + j * col_stride_] = e.Coeff(i, j);
+    }
+  }
+}
+
+#endif  // S21_MATRIX_VIEW_H_
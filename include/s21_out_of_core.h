@@ -0,0 +1,34 @@
+#ifndef S21_OUT_OF_CORE_H_
+#define S21_OUT_OF_CORE_H_
+
+#include <cstddef>
+#include <string>
+
+// Multiplies matrices stored in files written by S21Matrix::Save without
+// loading them: the product is computed one square tile of the result at a
+// time, streaming the matching tiles of the operands from disk and reading
+// the next pair in the background while the current one is multiplied. The
+// memory budget bounds the tile buffers, which are all the memory used
+// besides the multiplication kernel's own packing buffers.
+class S21OutOfCoreMultiplier {
+ public:
+  static const std::size_t kDefaultMemoryBudget;
+  static const int kMinTileSize;
+
+  S21OutOfCoreMultiplier(void);
+  explicit S21OutOfCoreMultiplier(std::size_t memory_budget);
+
+  std::size_t memory_budget(void) const noexcept;
+  void set_memory_budget(std::size_t memory_budget);
+  int tile_size(void) const noexcept;
+
+  // Writes lhs * rhs to result, which must not be one of the operands.
+  void Multiply(const std::string& lhs, const std::string& rhs,
+                const std::string& result) const;
+
+ private:
+  std::size_t memory_budget_;
+  int tile_size_;
+};
+
+#endif  // S21_OUT_OF_CORE_H_
@@ -0,0 +1,87 @@
+#ifndef S21_SPARSE_MATRIX_H_
+#define S21_SPARSE_MATRIX_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Matrix that stores only its nonzero elements, in compressed sparse row
+// (CSR) or compressed sparse column (CSC) form. Along the outer dimension,
+// rows for CSR and columns for CSC, offsets()[k] .. offsets()[k + 1] delimit
+// the positions of the nonzeros of line k in indices() and values(), sorted
+// by their inner index. Memory and the cost of every operation grow with the
+// number of nonzeros, not with rows * cols.
+class S21SparseMatrix {
+ public:
+  enum class Format { kCsr, kCsc };
+
+  struct Triplet {
+    int row;
+    int col;
+    double value;
+  };
+
+  S21SparseMatrix(void);
+  explicit S21SparseMatrix(int rows, int cols, Format format = Format::kCsr);
+  // Keeps the elements of dense whose magnitude is greater than threshold.
+  explicit S21SparseMatrix(const S21Matrix& dense,
+                           Format format = Format::kCsr,
+                           double threshold = 0.0);
+  // Builds the matrix from (row, col, value) entries in any order;
+  // duplicate entries are summed.
+  static S21SparseMatrix FromTriplets(int rows, int cols,
+                                      const std::vector<Triplet>& triplets,
+                                      Format format = Format::kCsr);
+
+  int rows(void) const noexcept;
+  int cols(void) const noexcept;
+  Format format(void) const noexcept;
+  std::size_t nonzeros(void) const noexcept;
+  const std::vector<std::size_t>& offsets(void) const noexcept;
+  const std::vector<int>& indices(void) const noexcept;
+  const std::vector<double>& values(void) const noexcept;
+
+  S21Matrix ToDense(void) const;
+  S21SparseMatrix ToFormat(Format format) const;
+  S21SparseMatrix Transpose(void) const;
+  bool EqMatrix(const S21SparseMatrix& other) const;
+  void SumMatrix(const S21SparseMatrix& other);
+  void SubMatrix(const S21SparseMatrix& other);
+  void MulMatrix(double num) noexcept;
+  // y = this * x
+  std::vector<double> MulVector(const std::vector<double>& x) const;
+  // this * dense
+  S21Matrix MulDense(const S21Matrix& dense) const;
+
+  S21SparseMatrix operator+(const S21SparseMatrix& other) const;
+  S21SparseMatrix operator-(const S21SparseMatrix& other) const;
+  S21SparseMatrix operator*(double num) const;
+  std::vector<double> operator*(const std::vector<double>& x) const;
+  S21Matrix operator*(const S21Matrix& dense) const;
+  bool operator==(const S21SparseMatrix& other) const;
+  S21SparseMatrix& operator+=(const S21SparseMatrix& other);
+  S21SparseMatrix& operator-=(const S21SparseMatrix& other);
+  S21SparseMatrix& operator*=(double num) noexcept;
+  // Zero for elements that are not stored.
+  double operator()(int i, int j) const;
+
+ private:
+  int rows_;
+  int cols_;
+  Format format_;
+  std::vector<std::size_t> offsets_;
+  std::vector<int> indices_;
+  std::vector<double> values_;
+
+  int outer(void) const noexcept;
+  int inner(void) const noexcept;
+  const S21SparseMatrix& Aligned(const S21SparseMatrix& other,
+                                 S21SparseMatrix& converted) const;
+  void Merge(const S21SparseMatrix& other, double sign);
+};
+
+// dense * sparse
+S21Matrix operator*(const S21Matrix& dense, const S21SparseMatrix& sparse);
+
+#endif  // S21_SPARSE_MATRIX_H_
@@ -0,0 +1,317 @@
+#include "s21_batch_kernels.h"
+
+#include <cstring>
+#include <limits>
+
+#include "s21_kernels.h"
+
+namespace s21 {
+
+namespace {
+
+// The bodies below are written once with GCC vector extensions over W
+// lanes, as many as the registers of the instruction set they are inlined
+// into hold, and run kBatchLanes / W times per chunk, once for each group of
+// lanes. Element e of a group starts at e * kBatchLanes. The vector type is
+// a member typedef because attributes do not survive as template arguments,
+// and the buffers are only aligned for doubles.
+template <int W>
+struct LaneVector {
+  typedef double Type
+      __attribute__((vector_size(W * sizeof(double)), aligned(sizeof(double))));
+};
+
+struct BatchKernelTable {
+  void (*product)(const double*, const double*, double*, int, int, int, int);
+  void (*determinant)(const double*, double*, double*, int, int);
+  bool (*inverse)(const double*, double*, double*, int, int, int);
+};
+
+#define S21_BATCH_INLINE inline __attribute__((always_inline))
+
+template <int W>
+S21_BATCH_INLINE typename LaneVector<W>::Type& At(double* base, int e) {
+  return (*reinterpret_cast<typename LaneVector<W>::Type*>(base +
+                                                           e * kBatchLanes));
+}
+
+template <int W>
+S21_BATCH_INLINE const typename LaneVector<W>::Type& At(const double* base,
+                                                        int e) {
+  return (*reinterpret_cast<const typename LaneVector<W>::Type*>(
+      base + e * kBatchLanes));
+}
+
+template <int W>
+S21_BATCH_INLINE void ProductBody(const double* a, const double* b,
+                                  double* c, int chunks, int m, int n,
+                                  int k) {
+  typedef typename LaneVector<W>::Type V;
+  for (int chunk = 0; chunk < chunks; ++chunk) {
+    for (int group = 0; group < kBatchLanes; group += W) {
+      for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < k; ++j) {
+          V sum = {};
+          for (int p = 0; p < n; ++p) {
+            sum += At<W>(a + group, i * n + p) * At<W>(b + group, p * k + j);
+          }
+          At<W>(c + group, i * k + j) = sum;
+        }
+      }
+    }
+    a += m * n * kBatchLanes;
+    b += n * k * kBatchLanes;
+    c += m * k * kBatchLanes;
+  }
+}
+
+// Closed forms up to 3x3, LU factorization with partial pivoting above.
+// Every lane picks its own pivot row, so rows are exchanged with blends.
+template <int W>
+S21_BATCH_INLINE void DeterminantBody(const double* a, double* det,
+                                      double* work, int chunks, int n) {
+  typedef typename LaneVector<W>::Type V;
+  typedef decltype(V{} < V{}) Mask;
+  for (int chunk = 0; chunk < chunks; ++chunk) {
+    for (int group = 0; group < kBatchLanes; group += W) {
+      const double* x = a + group;
+      double* w = work + group;
+      V d = V{} + 1.0;
+      if (n == 1) {
+        d = At<W>(x, 0);
+      } else if (n == 2) {
+        d = At<W>(x, 0) * At<W>(x, 3) - At<W>(x, 1) * At<W>(x, 2);
+      } else if (n == 3) {
+        d = At<W>(x, 0) *
+                (At<W>(x, 4) * At<W>(x, 8) - At<W>(x, 5) * At<W>(x, 7)) -
+            At<W>(x, 1) *
+                (At<W>(x, 3) * At<W>(x, 8) - At<W>(x, 5) * At<W>(x, 6)) +
+            At<W>(x, 2) *
+                (At<W>(x, 3) * At<W>(x, 7) - At<W>(x, 4) * At<W>(x, 6));
+      } else {
+        for (int e = 0; e < n * n; ++e) {
+          At<W>(w, e) = At<W>(x, e);
+        }
+        for (int k = 0; k < n; ++k) {
+          V best = At<W>(w, k * n + k);
+          best = best < 0.0 ? -best : best;
+          V row = V{} + k;
+          for (int i = k + 1; i < n; ++i) {
+            V value = At<W>(w, i * n + k);
+            value = value < 0.0 ? -value : value;
+            Mask larger = value > best;
+            best = larger ? value : best;
+            row = larger ? V{} + i : row;
+          }
+          for (int i = k + 1; i < n; ++i) {
+            Mask swap = row == i;
+            for (int j = k; j < n; ++j) {
+              V tmp = At<W>(w, k * n + j);
+              At<W>(w, k * n + j) = swap ? At<W>(w, i * n + j) : tmp;
+              At<W>(w, i * n + j) = swap ? tmp : At<W>(w, i * n + j);
+            }
+          }
+          V pivot = At<W>(w, k * n + k);
+          d = row != k ? -d : d;
+          d *= pivot;
+          // A zero pivot has already zeroed the determinant of its lane.
+          V divisor = pivot == 0.0 ? V{} + 1.0 : pivot;
+          for (int i = k + 1; i < n; ++i) {
+            V factor = At<W>(w, i * n + k) / divisor;
+            for (int j = k + 1; j < n; ++j) {
+              At<W>(w, i * n + j) -= factor * At<W>(w, k * n + j);
+            }
+          }
+        }
+      }
+      *reinterpret_cast<V*>(det + group) = d;
+    }
+    a += n * n * kBatchLanes;
+    det += kBatchLanes;
+  }
+}
+
+// Elimination on the augmented n x 2n matrix [a | I], which leaves the
+// inverse in the right half and needs no column swaps at the end.
+template <int W>
+S21_BATCH_INLINE bool InverseBody(const double* a, double* inverse,
+                                  double* work, int chunks, int n,
+                                  int count) {
+  typedef typename LaneVector<W>::Type V;
+  typedef decltype(V{} < V{}) Mask;
+  const int m = 2 * n;
+  bool regular = true;
+  for (int chunk = 0; regular && chunk < chunks; ++chunk) {
+    for (int group = 0; group < kBatchLanes; group += W) {
+      const double* x = a + group;
+      double* w = work + group;
+      V scale = {};
+      for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+          V value = At<W>(x, i * n + j);
+          V magnitude = value < 0.0 ? -value : value;
+          scale = magnitude > scale ? magnitude : scale;
+          At<W>(w, i * m + j) = value;
+          At<W>(w, i * m + n + j) = V{} + (i == j ? 1.0 : 0.0);
+        }
+      }
+      V tolerance = scale * (n * std::numeric_limits<double>::epsilon());
+      Mask singular = {};
+
+      for (int k = 0; k < n; ++k) {
+        V best = At<W>(w, k * m + k);
+        best = best < 0.0 ? -best : best;
+        V row = V{} + k;
+        for (int i = k + 1; i < n; ++i) {
+          V value = At<W>(w, i * m + k);
+          value = value < 0.0 ? -value : value;
+          Mask larger = value > best;
+          best = larger ? value : best;
+          row = larger ? V{} + i : row;
+        }
+        Mask tiny = best <= tolerance;
+        singular |= tiny;
+        for (int i = k + 1; i < n; ++i) {
+          Mask swap = row == i;
+          for (int j = k; j < m; ++j) {
+            V tmp = At<W>(w, k * m + j);
+            At<W>(w, k * m + j) = swap ? At<W>(w, i * m + j) : tmp;
+            At<W>(w, i * m + j) = swap ? tmp : At<W>(w, i * m + j);
+          }
+        }
+        V reciprocal = 1.0 / (tiny ? V{} + 1.0 : At<W>(w, k * m + k));
+        for (int j = k; j < m; ++j) {
+          At<W>(w, k * m + j) *= reciprocal;
+        }
+        for (int i = 0; i < n; ++i) {
+          V factor = At<W>(w, i * m + k);
+          for (int j = k; i != k && j < m; ++j) {
+            At<W>(w, i * m + j) -= factor * At<W>(w, k * m + j);
+          }
+        }
+      }
+
+      for (int lane = 0; lane < W; ++lane) {
+        if (singular[lane] && chunk * kBatchLanes + group + lane < count) {
+          regular = false;
+        }
+      }
+      for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+          At<W>(inverse + group, i * n + j) = At<W>(w, i * m + n + j);
+        }
+      }
+    }
+    a += n * n * kBatchLanes;
+    inverse += n * n * kBatchLanes;
+  }
+
+  return (regular);
+}
+
+// Below AVX2 the lanes are processed in pairs, which SSE2, part of the
+// x86-64 baseline, handles, so the scalar and SSE2 levels share these.
+
+void ProductBaseline(const double* a, const double* b, double* c, int chunks,
+                     int m, int n, int k) {
+  ProductBody<2>(a, b, c, chunks, m, n, k);
+}
+
+void DeterminantBaseline(const double* a, double* det, double* work,
+                         int chunks, int n) {
+  DeterminantBody<2>(a, det, work, chunks, n);
+}
+
+bool InverseBaseline(const double* a, double* inverse, double* work,
+                     int chunks, int n, int count) {
+  return (InverseBody<2>(a, inverse, work, chunks, n, count));
+}
+
+const BatchKernelTable kBaselineTable = {ProductBaseline, DeterminantBaseline,
+                                         InverseBaseline};
+
+#if defined(__x86_64__) || defined(__i386__)
+
+__attribute__((target("avx2"))) void ProductAvx2(const double* a,
+                                                 const double* b, double* c,
+                                                 int chunks, int m, int n,
+                                                 int k) {
+  ProductBody<4>(a, b, c, chunks, m, n, k);
+}
+
+__attribute__((target("avx2"))) void DeterminantAvx2(const double* a,
+                                                     double* det,
+                                                     double* work, int chunks,
+                                                     int n) {
+  DeterminantBody<4>(a, det, work, chunks, n);
+}
+
+__attribute__((target("avx2"))) bool InverseAvx2(const double* a,
+                                                 double* inverse,
+                                                 double* work, int chunks,
+                                                 int n, int count) {
+  return (InverseBody<4>(a, inverse, work, chunks, n, count));
+}
+
+const BatchKernelTable kAvx2Table = {ProductAvx2, DeterminantAvx2,
+                                     InverseAvx2};
+
+__attribute__((target("avx512f"))) void ProductAvx512(const double* a,
+                                                      const double* b,
+                                                      double* c, int chunks,
+                                                      int m, int n, int k) {
+  ProductBody<8>(a, b, c, chunks, m, n, k);
+}
+
+__attribute__((target("avx512f"))) void DeterminantAvx512(const double* a,
+                                                          double* det,
+                                                          double* work,
+                                                          int chunks, int n) {
+  DeterminantBody<8>(a, det, work, chunks, n);
+}
+
+__attribute__((target("avx512f"))) bool InverseAvx512(const double* a,
+                                                      double* inverse,
+                                                      double* work,
+                                                      int chunks, int n,
+                                                      int count) {
+  return (InverseBody<8>(a, inverse, work, chunks, n, count));
+}
+
+const BatchKernelTable kAvx512Table = {ProductAvx512, DeterminantAvx512,
+                                       InverseAvx512};
+
+#endif
+
+const BatchKernelTable& ActiveBatchTable(void) noexcept {
+  const BatchKernelTable* table = &kBaselineTable;
+#if defined(__x86_64__) || defined(__i386__)
+  SimdLevel level = ActiveSimdLevel();
+  if (level == SimdLevel::kAvx512) {
+    table = &kAvx512Table;
+  } else if (level == SimdLevel::kAvx2) {
+    table = &kAvx2Table;
+  }
+#endif
+
+  return (*table);
+}
+
+}  // namespace
+
+void BatchProductKernel(const double* a, const double* b, double* c,
+                        int chunks, int m, int n, int k) noexcept {
+  ActiveBatchTable().product(a, b, c, chunks, m, n, k);
+}
+
+void BatchDeterminantKernel(const double* a, double* det, double* work,
+                            int chunks, int n) noexcept {
+  ActiveBatchTable().determinant(a, det, work, chunks, n);
+}
+
+bool BatchInverseKernel(const double* a, double* inverse, double* work,
+                        int chunks, int n, int count) noexcept {
+  return (ActiveBatchTable().inverse(a, inverse, work, chunks, n, count));
+}
+
+}  // namespace s21
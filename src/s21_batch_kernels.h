@@ -0,0 +1,28 @@
+#ifndef S21_BATCH_KERNELS_H_
+#define S21_BATCH_KERNELS_H_
+
+namespace s21 {
+
+// Kernels over batches of small matrices stored in interleaved chunks: the
+// element (i, j) of kBatchLanes consecutive matrices is kBatchLanes adjacent
+// doubles, so one vector operation works on the same element of several
+// matrices and each SIMD lane follows a different matrix. A chunk of r x c
+// matrices is r * c * kBatchLanes doubles. Like the element-wise kernels they
+// run at the SIMD level selected in s21_kernels.h.
+const int kBatchLanes = 8;
+
+// c = a * b for every lane; a is m x n, b is n x k and c is m x k.
+void BatchProductKernel(const double* a, const double* b, double* c,
+                        int chunks, int m, int n, int k) noexcept;
+// det[lane] for every lane of the n x n chunks of a. work holds one chunk.
+void BatchDeterminantKernel(const double* a, double* det, double* work,
+                            int chunks, int n) noexcept;
+// Gauss-Jordan elimination with partial pivoting in every lane. work holds
+// two chunks. Returns false when one of the first count matrices is
+// singular; inverse is then only partly written.
+bool BatchInverseKernel(const double* a, double* inverse, double* work,
+                        int chunks, int n, int count) noexcept;
+
+}  // namespace s21
+
+#endif  // S21_BATCH_KERNELS_H_
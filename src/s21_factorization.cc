@@ -0,0 +1,509 @@
+#include "s21_factorization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_gemm.h"
+#include "s21_kernels.h"
+#include "s21_matrix_view.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Below this size the trailing update of a factorization step is too small
+// to be worth splitting across the pool.
+const int kParallelMinSize = 128;
+const int kParallelGrain = 16;
+
+void CheckSquare(const S21Matrix& matrix) {
+  if (matrix.rows() != matrix.cols()) {
+    throw std::invalid_argument("The matrix is not square.");
+  }
+}
+
+void CheckRightHandSide(int rows, std::size_t size) {
+  if (static_cast<std::size_t>(rows) != size) {
+    throw std::invalid_argument("The matrices are incompatible.");
+  }
+}
+
+void ThrowSingular(void) {
+  throw std::invalid_argument(
+      "The matrix is singular and there is no inverse matrix.");
+}
+
+double* Row(const S21MatrixView& view, int i) noexcept {
+  return (view.data() + i * view.row_stride());
+}
+
+const double* Row(const S21ConstMatrixView& view, int i) noexcept {
+  return (view.data() + i * view.row_stride());
+}
+
+double Tolerance(const S21Matrix& matrix) noexcept {
+  double max_abs = 0.0;
+  S21ConstMatrixView view = matrix.View();
+  for (int i = 0; i < view.rows(); ++i) {
+    for (int j = 0; j < view.cols(); ++j) {
+      max_abs = std::max(max_abs, fabs(Row(view, i)[j]));
+    }
+  }
+
+  return (std::max(matrix.rows(), matrix.cols()) *
+          std::numeric_limits<double>::epsilon() * max_abs);
+}
+
+void SubtractProduct(const S21ConstMatrixView& a, const S21ConstMatrixView& b,
+                     const S21MatrixView& c) {
+  s21::Gemm(c.rows(), c.cols(), a.cols(), a.data(), a.row_stride(),
+            a.col_stride(), b.data(), b.row_stride(), b.col_stride(),
+            c.data(), c.row_stride(), c.col_stride(), -1.0);
+}
+
+S21Matrix Identity(int n) {
+  S21Matrix identity(n, n);
+  for (int i = 0; i < n; ++i) {
+    identity(i, i) = 1.0;
+  }
+
+  return (identity);
+}
+
+// The triangular solves below overwrite x, n x r, with the solution. The
+// matrix versions update whole rows of right-hand sides with the SIMD
+// kernels and, from S21LU::kBlockedMinSize on, go block row by block row:
+// the rows already solved are eliminated from the next block by one GEMM
+// and only the diagonal block is solved row by row. The vector versions are
+// dot products along rows of the factor. A transposed view of a lower factor
+// serves as the upper one.
+
+void LowerSolveBlock(const S21ConstMatrixView& l, bool unit,
+                     const S21MatrixView& x) {
+  for (int i = 0; i < l.rows(); ++i) {
+    double* x_i = Row(x, i);
+    for (int k = 0; k < i; ++k) {
+      s21::AxpyKernel(x_i, -l.Coeff(i, k), Row(x, k), x.cols());
+    }
+    if (!unit) {
+      s21::ScaleKernel(x_i, 1.0 / l.Coeff(i, i), x.cols());
+    }
+  }
+}
+
+void UpperSolveBlock(const S21ConstMatrixView& u, const S21MatrixView& x) {
+  for (int i = u.rows() - 1; i >= 0; --i) {
+    double* x_i = Row(x, i);
+    for (int k = i + 1; k < u.rows(); ++k) {
+      s21::AxpyKernel(x_i, -u.Coeff(i, k), Row(x, k), x.cols());
+    }
+    s21::ScaleKernel(x_i, 1.0 / u.Coeff(i, i), x.cols());
+  }
+}
+
+void LowerSolve(const S21ConstMatrixView& l, bool unit,
+                const S21MatrixView& x) {
+  int n = l.rows();
+  int block = n < S21LU::kBlockedMinSize ? n : S21LU::kBlockSize;
+  for (int b = 0; b < n; b += block) {
+    int width = std::min(block, n - b);
+    S21MatrixView x_b = x.Block(b, 0, width, x.cols());
+    if (b > 0) {
+      SubtractProduct(l.Block(b, 0, width, b), x.Block(0, 0, b, x.cols()),
+                      x_b);
+    }
+    LowerSolveBlock(l.Block(b, b, width, width), unit, x_b);
+  }
+}
+
+void UpperSolve(const S21ConstMatrixView& u, const S21MatrixView& x) {
+  int n = u.rows();
+  int block = n < S21LU::kBlockedMinSize ? n : S21LU::kBlockSize;
+  for (int end = n; end > 0; end -= block) {
+    int b = std::max(0, end - block);
+    S21MatrixView x_b = x.Block(b, 0, end - b, x.cols());
+    if (end < n) {
+      SubtractProduct(u.Block(b, end, end - b, n - end),
+                      x.Block(end, 0, n - end, x.cols()), x_b);
+    }
+    UpperSolveBlock(u.Block(b, b, end - b, end - b), x_b);
+  }
+}
+
+void LowerSolve(const S21ConstMatrixView& l, bool unit, double* x) {
+  for (int i = 0; i < l.rows(); ++i) {
+    double sum = x[i];
+    for (int k = 0; k < i; ++k) {
+      sum -= l.Coeff(i, k) * x[k];
+    }
+    x[i] = unit ? sum : sum / l.Coeff(i, i);
+  }
+}
+
+void UpperSolve(const S21ConstMatrixView& u, double* x) {
+  for (int i = u.rows() - 1; i >= 0; --i) {
+    double sum = x[i];
+    for (int k = i + 1; k < u.rows(); ++k) {
+      sum -= u.Coeff(i, k) * x[k];
+    }
+    x[i] = sum / u.Coeff(i, i);
+  }
+}
+
+}  // namespace
+
+// LU.
+
+const int S21LU::kBlockedMinSize = 256;
+const int S21LU::kBlockSize = 64;
+
+S21LU::S21LU(const S21Matrix& matrix)
+    : lu_(matrix), pivots_(matrix.rows()), sign_(1), singular_(false) {
+  CheckSquare(matrix);
+
+  int n = lu_.rows();
+  double tolerance = Tolerance(matrix);
+  S21MatrixView lu = lu_.View();
+  for (int i = 0; i < n; ++i) {
+    pivots_[i] = i;
+  }
+
+  if (n < kBlockedMinSize) {
+    FactorPanel(lu, 0, n, tolerance);
+  } else {
+    FactorBlocked(lu, 0, n, tolerance);
+  }
+}
+
+int S21LU::size(void) const noexcept { return (lu_.rows()); }
+
+const S21Matrix& S21LU::factors(void) const noexcept { return (lu_); }
+
+const std::vector<int>& S21LU::pivots(void) const noexcept {
+  return (pivots_);
+}
+
+bool S21LU::IsSingular(void) const noexcept { return (singular_); }
+
+std::vector<double> S21LU::Solve(const std::vector<double>& b) const {
+  CheckRightHandSide(size(), b.size());
+  CheckRegular();
+
+  std::vector<double> x(b.size());
+  for (int i = 0; i < size(); ++i) {
+    x[i] = b[pivots_[i]];
+  }
+  LowerSolve(lu_.View(), true, x.data());
+  UpperSolve(lu_.View(), x.data());
+
+  return (x);
+}
+
+S21Matrix S21LU::Solve(const S21Matrix& b) const {
+  CheckRightHandSide(size(), b.rows());
+  CheckRegular();
+
+  S21Matrix x(b.rows(), b.cols());
+  S21ConstMatrixView from = b.View();
+  S21MatrixView to = x.View();
+  for (int i = 0; i < size(); ++i) {
+    std::copy(Row(from, pivots_[i]), Row(from, pivots_[i]) + b.cols(),
+              Row(to, i));
+  }
+  LowerSolve(lu_.View(), true, to);
+  UpperSolve(lu_.View(), to);
+
+  return (x);
+}
+
+double S21LU::Determinant(void) const noexcept {
+  double det = sign_;
+  S21ConstMatrixView lu = lu_.View();
+  for (int i = 0; i < size(); ++i) {
+    det *= lu.Coeff(i, i);
+  }
+
+  return (det);
+}
+
+S21Matrix S21LU::Inverse(void) const { return (Solve(Identity(size()))); }
+
+void S21LU::CheckRegular(void) const {
+  if (singular_) {
+    ThrowSingular();
+  }
+}
+
+// Unblocked right-looking elimination of the columns [col, col + width)
+// over the rows below col. Pivoting exchanges whole rows, so the columns
+// left and right of the panel follow the interchanges. The rank-1 update of
+// each step is split into row panels across the pool.
+void S21LU::FactorPanel(const S21MatrixView& lu, int col, int width,
+                        double tolerance) {
+  int n = lu.rows();
+  int last = col + width;
+  s21::ThreadPool& pool = s21::ThreadPool::Instance();
+  int grain = n < kParallelMinSize ? n : kParallelGrain;
+  for (int k = col; k < last; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < n; ++i) {
+      if (fabs(Row(lu, i)[k]) > fabs(Row(lu, pivot)[k])) {
+        pivot = i;
+      }
+    }
+    if (pivot != k) {
+      std::swap_ranges(Row(lu, k), Row(lu, k) + n, Row(lu, pivot));
+      std::swap(pivots_[k], pivots_[pivot]);
+      sign_ = -sign_;
+    }
+
+    double* row_k = Row(lu, k);
+    if (fabs(row_k[k]) <= tolerance) {
+      singular_ = true;
+    }
+    if (row_k[k] != 0.0) {
+      pool.ParallelFor(n - k - 1, grain, [&](int begin, int end) {
+        for (int i = k + 1 + begin; i < k + 1 + end; ++i) {
+          double* row_i = Row(lu, i);
+          row_i[k] /= row_k[k];
+          s21::AxpyKernel(row_i + k + 1, -row_i[k], row_k + k + 1,
+                          last - k - 1);
+        }
+      });
+    }
+  }
+}
+
+// Recursive LU of the columns [col, col + width): the left half is factored,
+// the top of the right half is solved against its unit lower triangle and
+// the rest of the right half is updated by one GEMM before it is factored in
+// turn. Nearly all of the flops end up in the GEMMs, which are blocked for
+// the caches and parallel on their own; panels of up to kBlockSize columns
+// are left to FactorPanel.
+void S21LU::FactorBlocked(const S21MatrixView& lu, int col, int width,
+                          double tolerance) {
+  if (width <= kBlockSize) {
+    FactorPanel(lu, col, width, tolerance);
+    return;
+  }
+
+  int n = lu.rows();
+  int left = width / 2;
+  int right = width - left;
+  int mid = col + left;
+  FactorBlocked(lu, col, left, tolerance);
+  s21::ThreadPool::Instance().ParallelFor(
+      right, kParallelGrain, [&](int begin, int end) {
+        LowerSolveBlock(lu.Block(col, col, left, left), true,
+                        lu.Block(col, mid + begin, left, end - begin));
+      });
+  SubtractProduct(lu.Block(mid, col, n - mid, left),
+                  lu.Block(col, mid, left, right),
+                  lu.Block(mid, mid, n - mid, right));
+  FactorBlocked(lu, mid, right, tolerance);
+}
+
+// Cholesky.
+
+S21Cholesky::S21Cholesky(const S21Matrix& matrix)
+    : l_(matrix.rows(), matrix.cols()) {
+  CheckSquare(matrix);
+
+  int n = l_.rows();
+  S21ConstMatrixView a = matrix.View();
+  S21MatrixView l = l_.View();
+  for (int j = 0; j < n; ++j) {
+    const double* row_j = Row(l, j);
+    double diagonal = a.Coeff(j, j);
+    for (int k = 0; k < j; ++k) {
+      diagonal -= row_j[k] * row_j[k];
+    }
+    if (!(diagonal > 0.0)) {
+      throw std::invalid_argument("The matrix is not positive definite.");
+    }
+    Row(l, j)[j] = sqrt(diagonal);
+
+    for (int i = j + 1; i < n; ++i) {
+      double* row_i = Row(l, i);
+      double sum = a.Coeff(i, j);
+      for (int k = 0; k < j; ++k) {
+        sum -= row_i[k] * row_j[k];
+      }
+      row_i[j] = sum / row_j[j];
+    }
+  }
+}
+
+int S21Cholesky::size(void) const noexcept { return (l_.rows()); }
+
+const S21Matrix& S21Cholesky::factor(void) const noexcept { return (l_); }
+
+std::vector<double> S21Cholesky::Solve(const std::vector<double>& b) const {
+  CheckRightHandSide(size(), b.size());
+
+  std::vector<double> x(b);
+  LowerSolve(l_.View(), false, x.data());
+  UpperSolve(l_.View().Transposed(), x.data());
+
+  return (x);
+}
+
+S21Matrix S21Cholesky::Solve(const S21Matrix& b) const {
+  CheckRightHandSide(size(), b.rows());
+
+  S21Matrix x(b);
+  LowerSolve(l_.View(), false, x.View());
+  UpperSolve(l_.View().Transposed(), x.View());
+
+  return (x);
+}
+
+double S21Cholesky::Determinant(void) const noexcept {
+  double det = 1.0;
+  S21ConstMatrixView l = l_.View();
+  for (int i = 0; i < size(); ++i) {
+    det *= l.Coeff(i, i) * l.Coeff(i, i);
+  }
+
+  return (det);
+}
+
+S21Matrix S21Cholesky::Inverse(void) const {
+  return (Solve(Identity(size())));
+}
+
+// QR.
+
+// Column k is reduced by H = I - tau v v^T with v = (1, tail), chosen as in
+// LAPACK's dlarfg. Applying H to the trailing columns is done a row at a
+// time: w = v^T A is accumulated from whole rows, then every row i loses
+// tau v_i w.
+S21QR::S21QR(const S21Matrix& matrix)
+    : qr_(matrix), tau_(matrix.cols(), 0.0), rank_deficient_(false) {
+  if (matrix.rows() < matrix.cols()) {
+    throw std::invalid_argument("The matrix has fewer rows than columns.");
+  }
+
+  int m = qr_.rows();
+  int n = qr_.cols();
+  double tolerance = Tolerance(matrix);
+  S21MatrixView qr = qr_.View();
+  std::vector<double> w(n);
+  for (int k = 0; k < n; ++k) {
+    double alpha = Row(qr, k)[k];
+    double tail = 0.0;
+    for (int i = k + 1; i < m; ++i) {
+      tail += Row(qr, i)[k] * Row(qr, i)[k];
+    }
+
+    if (tail != 0.0) {
+      double beta = -std::copysign(sqrt(alpha * alpha + tail), alpha);
+      tau_[k] = (beta - alpha) / beta;
+      for (int i = k + 1; i < m; ++i) {
+        Row(qr, i)[k] /= alpha - beta;
+      }
+      Row(qr, k)[k] = beta;
+
+      int width = n - k - 1;
+      std::copy(Row(qr, k) + k + 1, Row(qr, k) + n, w.begin());
+      for (int i = k + 1; i < m; ++i) {
+        s21::AxpyKernel(w.data(), Row(qr, i)[k], Row(qr, i) + k + 1, width);
+      }
+      s21::AxpyKernel(Row(qr, k) + k + 1, -tau_[k], w.data(), width);
+      for (int i = k + 1; i < m; ++i) {
+        s21::AxpyKernel(Row(qr, i) + k + 1, -tau_[k] * Row(qr, i)[k],
+                        w.data(), width);
+      }
+    }
+    if (fabs(Row(qr, k)[k]) <= tolerance) {
+      rank_deficient_ = true;
+    }
+  }
+}
+
+int S21QR::rows(void) const noexcept { return (qr_.rows()); }
+
+int S21QR::cols(void) const noexcept { return (qr_.cols()); }
+
+const S21Matrix& S21QR::factors(void) const noexcept { return (qr_); }
+
+bool S21QR::IsRankDeficient(void) const noexcept { return (rank_deficient_); }
+
+std::vector<double> S21QR::Solve(const std::vector<double>& b) const {
+  CheckRightHandSide(rows(), b.size());
+  CheckFullRank();
+
+  // y = Q^T b, one reflector at a time.
+  std::vector<double> y(b);
+  S21ConstMatrixView qr = qr_.View();
+  for (int k = 0; k < cols(); ++k) {
+    double dot = y[k];
+    for (int i = k + 1; i < rows(); ++i) {
+      dot += qr.Coeff(i, k) * y[i];
+    }
+    y[k] -= tau_[k] * dot;
+    for (int i = k + 1; i < rows(); ++i) {
+      y[i] -= tau_[k] * dot * qr.Coeff(i, k);
+    }
+  }
+  y.resize(cols());
+  UpperSolve(qr.Block(0, 0, cols(), cols()), y.data());
+
+  return (y);
+}
+
+S21Matrix S21QR::Solve(const S21Matrix& b) const {
+  CheckRightHandSide(rows(), b.rows());
+  CheckFullRank();
+
+  S21Matrix y(b);
+  S21MatrixView to = y.View();
+  S21ConstMatrixView qr = qr_.View();
+  std::vector<double> w(b.cols());
+  for (int k = 0; k < cols(); ++k) {
+    std::copy(Row(to, k), Row(to, k) + b.cols(), w.begin());
+    for (int i = k + 1; i < rows(); ++i) {
+      s21::AxpyKernel(w.data(), qr.Coeff(i, k), Row(to, i), b.cols());
+    }
+    s21::AxpyKernel(Row(to, k), -tau_[k], w.data(), b.cols());
+    for (int i = k + 1; i < rows(); ++i) {
+      s21::AxpyKernel(Row(to, i), -tau_[k] * qr.Coeff(i, k), w.data(),
+                      b.cols());
+    }
+  }
+
+  S21Matrix x(to.Block(0, 0, cols(), b.cols()));
+  UpperSolve(qr.Block(0, 0, cols(), cols()), x.View());
+
+  return (x);
+}
+
+// Every reflector with tau != 0 has determinant -1.
+double S21QR::Determinant(void) const {
+  if (rows() != cols()) {
+    throw std::invalid_argument("The matrix is not square.");
+  }
+
+  double det = 1.0;
+  S21ConstMatrixView qr = qr_.View();
+  for (int k = 0; k < cols(); ++k) {
+    det *= tau_[k] != 0.0 ? -qr.Coeff(k, k) : qr.Coeff(k, k);
+  }
+
+  return (det);
+}
+
+S21Matrix S21QR::Inverse(void) const {
+  if (rows() != cols()) {
+    throw std::invalid_argument("The matrix is not square.");
+  }
+
+  return (Solve(Identity(rows())));
+}
+
+void S21QR::CheckFullRank(void) const {
+  if (rank_deficient_) {
+    ThrowSingular();
+  }
+}
@@ -0,0 +1,369 @@
+#include "s21_gemm.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+typedef double Vec2 __attribute__((vector_size(2 * sizeof(double))));
+typedef float Vec4 __attribute__((vector_size(4 * sizeof(float))));
+
+// Products below this many multiply-adds are not worth packing, and
+// products below kGemmParallelSize are not worth waking the thread pool.
+constexpr long kGemmSmallSize = 32L * 32L * 32L;
+constexpr long kGemmParallelSize = 96L * 96L * 96L;
+
+// Packing buffers are kept per thread and element type so that repeated
+// products do not go back to the allocator.
+template <typename T>
+thread_local std::vector<T> packed_a_buffer;
+template <typename T>
+thread_local std::vector<T> packed_b_buffer;
+
+template <typename T>
+T* PackingBuffer(std::vector<T>& buffer, std::size_t size) {
+  if (buffer.size() < size) {
+    buffer.resize(size);
+  }
+
+  return (buffer.data());
+}
+
+// Complex products are expanded into real arithmetic instead of going
+// through operator*, whose recovery of infinite results from NaN parts is a
+// library call per product. Every path of Gemm multiplies this way, so a
+// product does not depend on the size of the matrices.
+template <typename T>
+T Multiply(T x, T y) {
+  return (x * y);
+}
+
+std::complex<double> Multiply(std::complex<double> x,
+                              std::complex<double> y) {
+  return (std::complex<double>(x.real() * y.real() - x.imag() * y.imag(),
+                               x.real() * y.imag() + x.imag() * y.real()));
+}
+
+template <typename T>
+void SmallGemm(int m, int n, int k, const T* a, std::ptrdiff_t rsa,
+               std::ptrdiff_t csa, const T* b, std::ptrdiff_t rsb,
+               std::ptrdiff_t csb, T* c, std::ptrdiff_t rsc,
+               std::ptrdiff_t csc, T alpha) {
+  for (int i = 0; i < m; ++i) {
+    for (int p = 0; p < k; ++p) {
+      T a_ip = Multiply(alpha, a[i * rsa + p * csa]);
+      const T* b_p = b + p * rsb;
+      T* c_i = c + i * rsc;
+      for (int j = 0; j < n; ++j) {
+        c_i[j * csc] += Multiply(a_ip, b_p[j * csb]);
+      }
+    }
+  }
+}
+
+// Packs an mc x kc block of alpha * A into row micro-panels of kGemmMr rows
+// stored column by column; rows past mc are zero-filled.
+template <typename T>
+void PackA(int mc, int kc, const T* a, std::ptrdiff_t rsa,
+           std::ptrdiff_t csa, T alpha, T* packed) {
+  for (int ir = 0; ir < mc; ir += kGemmMr) {
+    int mr = std::min(kGemmMr, mc - ir);
+    for (int p = 0; p < kc; ++p) {
+      for (int r = 0; r < mr; ++r) {
+        packed[r] = Multiply(alpha, a[(ir + r) * rsa + p * csa]);
+      }
+      for (int r = mr; r < kGemmMr; ++r) {
+        packed[r] = T(0);
+      }
+      packed += kGemmMr;
+    }
+  }
+}
+
+// Packs a kc x nc panel of B into column micro-panels of kGemmNr columns
+// stored row by row; columns past nc are zero-filled.
+template <typename T>
+void PackB(int kc, int nc, const T* b, std::ptrdiff_t rsb,
+           std::ptrdiff_t csb, T* packed) {
+  for (int jr = 0; jr < nc; jr += kGemmNr) {
+    int nr = std::min(kGemmNr, nc - jr);
+    for (int p = 0; p < kc; ++p) {
+      const T* b_p = b + p * rsb + jr * csb;
+      if (nr == kGemmNr && csb == 1) {
+        memcpy(packed, b_p, kGemmNr * sizeof(*packed));
+      } else {
+        for (int j = 0; j < nr; ++j) {
+          packed[j] = b_p[j * csb];
+        }
+        for (int j = nr; j < kGemmNr; ++j) {
+          packed[j] = T(0);
+        }
+      }
+      packed += kGemmNr;
+    }
+  }
+}
+
+// Multiplies a packed kGemmMr x kc micro-panel of A by a packed
+// kc x kGemmNr micro-panel of B and adds the top-left mr x nr corner of the
+// product to C. The tile is computed in two halves of four columns so that
+// the accumulators fit in the sixteen SSE2 registers of the baseline target.
+void MicroKernel(int kc, const double* a, const double* b, int mr, int nr,
+                 double* c, std::ptrdiff_t rsc, std::ptrdiff_t csc) {
+  double tile[kGemmMr][kGemmNr];
+
+  for (int half = 0; half < kGemmNr; half += 4) {
+    Vec2 c00 = {0.0, 0.0}, c01 = {0.0, 0.0};
+    Vec2 c10 = {0.0, 0.0}, c11 = {0.0, 0.0};
+    Vec2 c20 = {0.0, 0.0}, c21 = {0.0, 0.0};
+    Vec2 c30 = {0.0, 0.0}, c31 = {0.0, 0.0};
+    const double* a_p = a;
+    const double* b_p = b + half;
+
+    for (int p = 0; p < kc; ++p) {
+      Vec2 b0;
+      Vec2 b1;
+      memcpy(&b0, b_p, sizeof(b0));
+      memcpy(&b1, b_p + 2, sizeof(b1));
+      Vec2 a0 = {a_p[0], a_p[0]};
+      Vec2 a1 = {a_p[1], a_p[1]};
+      Vec2 a2 = {a_p[2], a_p[2]};
+      Vec2 a3 = {a_p[3], a_p[3]};
+      c00 += a0 * b0;
+      c01 += a0 * b1;
+      c10 += a1 * b0;
+      c11 += a1 * b1;
+      c20 += a2 * b0;
+      c21 += a2 * b1;
+      c30 += a3 * b0;
+      c31 += a3 * b1;
+      a_p += kGemmMr;
+      b_p += kGemmNr;
+    }
+
+    memcpy(&tile[0][half], &c00, sizeof(c00));
+    memcpy(&tile[0][half + 2], &c01, sizeof(c01));
+    memcpy(&tile[1][half], &c10, sizeof(c10));
+    memcpy(&tile[1][half + 2], &c11, sizeof(c11));
+    memcpy(&tile[2][half], &c20, sizeof(c20));
+    memcpy(&tile[2][half + 2], &c21, sizeof(c21));
+    memcpy(&tile[3][half], &c30, sizeof(c30));
+    memcpy(&tile[3][half + 2], &c31, sizeof(c31));
+  }
+
+  for (int r = 0; r < mr; ++r) {
+    double* c_r = c + r * rsc;
+    for (int j = 0; j < nr; ++j) {
+      c_r[j * csc] += tile[r][j];
+    }
+  }
+}
+
+// Four rows of eight floats fit in two vectors each, so the float tile
+// needs only one pass.
+void MicroKernel(int kc, const float* a, const float* b, int mr, int nr,
+                 float* c, std::ptrdiff_t rsc, std::ptrdiff_t csc) {
+  float tile[kGemmMr][kGemmNr];
+  Vec4 c00 = {0.0f, 0.0f, 0.0f, 0.0f}, c01 = {0.0f, 0.0f, 0.0f, 0.0f};
+  Vec4 c10 = {0.0f, 0.0f, 0.0f, 0.0f}, c11 = {0.0f, 0.0f, 0.0f, 0.0f};
+  Vec4 c20 = {0.0f, 0.0f, 0.0f, 0.0f}, c21 = {0.0f, 0.0f, 0.0f, 0.0f};
+  Vec4 c30 = {0.0f, 0.0f, 0.0f, 0.0f}, c31 = {0.0f, 0.0f, 0.0f, 0.0f};
+
+  for (int p = 0; p < kc; ++p) {
+    Vec4 b0;
+    Vec4 b1;
+    memcpy(&b0, b, sizeof(b0));
+    memcpy(&b1, b + 4, sizeof(b1));
+    Vec4 a0 = {a[0], a[0], a[0], a[0]};
+    Vec4 a1 = {a[1], a[1], a[1], a[1]};
+    Vec4 a2 = {a[2], a[2], a[2], a[2]};
+    Vec4 a3 = {a[3], a[3], a[3], a[3]};
+    c00 += a0 * b0;
+    c01 += a0 * b1;
+    c10 += a1 * b0;
+    c11 += a1 * b1;
+    c20 += a2 * b0;
+    c21 += a2 * b1;
+    c30 += a3 * b0;
+    c31 += a3 * b1;
+    a += kGemmMr;
+    b += kGemmNr;
+  }
+
+  memcpy(&tile[0][0], &c00, sizeof(c00));
+  memcpy(&tile[0][4], &c01, sizeof(c01));
+  memcpy(&tile[1][0], &c10, sizeof(c10));
+  memcpy(&tile[1][4], &c11, sizeof(c11));
+  memcpy(&tile[2][0], &c20, sizeof(c20));
+  memcpy(&tile[2][4], &c21, sizeof(c21));
+  memcpy(&tile[3][0], &c30, sizeof(c30));
+  memcpy(&tile[3][4], &c31, sizeof(c31));
+  for (int r = 0; r < mr; ++r) {
+    float* c_r = c + r * rsc;
+    for (int j = 0; j < nr; ++j) {
+      c_r[j * csc] += tile[r][j];
+    }
+  }
+}
+
+// The products are expanded like in Multiply.
+void MicroKernel(int kc, const std::complex<double>* a,
+                 const std::complex<double>* b, int mr, int nr,
+                 std::complex<double>* c, std::ptrdiff_t rsc,
+                 std::ptrdiff_t csc) {
+  double re[kGemmMr][kGemmNr] = {};
+  double im[kGemmMr][kGemmNr] = {};
+
+  for (int p = 0; p < kc; ++p) {
+    for (int r = 0; r < kGemmMr; ++r) {
+      double a_re = a[r].real();
+      double a_im = a[r].imag();
+      for (int j = 0; j < kGemmNr; ++j) {
+        re[r][j] += a_re * b[j].real() - a_im * b[j].imag();
+        im[r][j] += a_re * b[j].imag() + a_im * b[j].real();
+      }
+    }
+    a += kGemmMr;
+    b += kGemmNr;
+  }
+
+  for (int r = 0; r < mr; ++r) {
+    std::complex<double>* c_r = c + r * rsc;
+    for (int j = 0; j < nr; ++j) {
+      c_r[j * csc] += std::complex<double>(re[r][j], im[r][j]);
+    }
+  }
+}
+
+// Long double elements have no vector arithmetic to use.
+template <typename T>
+void MicroKernel(int kc, const T* a, const T* b, int mr, int nr, T* c,
+                 std::ptrdiff_t rsc, std::ptrdiff_t csc) {
+  T tile[kGemmMr][kGemmNr] = {};
+
+  for (int p = 0; p < kc; ++p) {
+    for (int r = 0; r < kGemmMr; ++r) {
+      for (int j = 0; j < kGemmNr; ++j) {
+        tile[r][j] += a[r] * b[j];
+      }
+    }
+    a += kGemmMr;
+    b += kGemmNr;
+  }
+
+  for (int r = 0; r < mr; ++r) {
+    T* c_r = c + r * rsc;
+    for (int j = 0; j < nr; ++j) {
+      c_r[j * csc] += tile[r][j];
+    }
+  }
+}
+
+template <typename T>
+void MacroKernel(int mc, int nc, int kc, const T* packed_a,
+                 const T* packed_b, T* c, std::ptrdiff_t rsc,
+                 std::ptrdiff_t csc) {
+  for (int jr = 0; jr < nc; jr += kGemmNr) {
+    int nr = std::min(kGemmNr, nc - jr);
+    const T* b_panel = packed_b + jr * kc;
+    for (int ir = 0; ir < mc; ir += kGemmMr) {
+      int mr = std::min(kGemmMr, mc - ir);
+      MicroKernel(kc, packed_a + ir * kc, b_panel, mr, nr,
+                  c + ir * rsc + jr * csc, rsc, csc);
+    }
+  }
+}
+
+template <typename T>
+void BlockedGemm(int m, int n, int k, const T* a, std::ptrdiff_t rsa,
+                 std::ptrdiff_t csa, const T* b, std::ptrdiff_t rsb,
+                 std::ptrdiff_t csb, T* c, std::ptrdiff_t rsc,
+                 std::ptrdiff_t csc, T alpha = T(1)) {
+  if (static_cast<long>(m) * n * k <= kGemmSmallSize) {
+    SmallGemm(m, n, k, a, rsa, csa, b, rsb, csb, c, rsc, csc, alpha);
+    return;
+  }
+
+  ThreadPool& pool = ThreadPool::Instance();
+  bool parallel = static_cast<long>(m) * n * k >= kGemmParallelSize;
+  T* packed_b = PackingBuffer(packed_b_buffer<T>,
+                              static_cast<std::size_t>(kGemmKc) * kGemmNc);
+
+  for (int jc = 0; jc < n; jc += kGemmNc) {
+    int nc = std::min(kGemmNc, n - jc);
+    int col_panels = (nc + kGemmNr - 1) / kGemmNr;
+    for (int pc = 0; pc < k; pc += kGemmKc) {
+      int kc = std::min(kGemmKc, k - pc);
+      PackB(kc, nc, b + pc * rsb + jc * csb, rsb, csb, packed_b);
+
+      // The output is split into row panels of kGemmMc rows and, when there
+      // are fewer row panels than threads, into column panels as well.
+      int row_blocks = (m + kGemmMc - 1) / kGemmMc;
+      int col_chunks = 1;
+      if (parallel) {
+        col_chunks = (pool.size() + row_blocks - 1) / row_blocks;
+        col_chunks = std::min(col_chunks, col_panels);
+      }
+      int tasks = row_blocks * col_chunks;
+      pool.ParallelFor(tasks, parallel ? 1 : tasks, [&](int begin, int end) {
+        T* packed_a = PackingBuffer(
+            packed_a_buffer<T>, static_cast<std::size_t>(kGemmMc) * kGemmKc);
+        int packed_block = -1;
+        for (int task = begin; task < end; ++task) {
+          int block = task / col_chunks;
+          int chunk = task % col_chunks;
+          int ic = block * kGemmMc;
+          int mc = std::min(kGemmMc, m - ic);
+          if (block != packed_block) {
+            PackA(mc, kc, a + ic * rsa + pc * csa, rsa, csa, alpha,
+                  packed_a);
+            packed_block = block;
+          }
+          int j0 = col_panels * chunk / col_chunks * kGemmNr;
+          int j1 = std::min(
+              nc, col_panels * (chunk + 1) / col_chunks * kGemmNr);
+          MacroKernel(mc, j1 - j0, kc, packed_a, packed_b + j0 * kc,
+                      c + ic * rsc + (jc + j0) * csc, rsc, csc);
+        }
+      });
+    }
+  }
+}
+
+}  // namespace
+
+void Gemm(int m, int n, int k, const double* a, std::ptrdiff_t rsa,
+          std::ptrdiff_t csa, const double* b, std::ptrdiff_t rsb,
+          std::ptrdiff_t csb, double* c, std::ptrdiff_t rsc,
+          std::ptrdiff_t csc, double alpha) {
+  BlockedGemm(m, n, k, a, rsa, csa, b, rsb, csb, c, rsc, csc, alpha);
+}
+
+void Gemm(int m, int n, int k, const float* a, std::ptrdiff_t rsa,
+          std::ptrdiff_t csa, const float* b, std::ptrdiff_t rsb,
+          std::ptrdiff_t csb, float* c, std::ptrdiff_t rsc,
+          std::ptrdiff_t csc) {
+  BlockedGemm(m, n, k, a, rsa, csa, b, rsb, csb, c, rsc, csc);
+}
+
+void Gemm(int m, int n, int k, const long double* a, std::ptrdiff_t rsa,
+          std::ptrdiff_t csa, const long double* b, std::ptrdiff_t rsb,
+          std::ptrdiff_t csb, long double* c, std::ptrdiff_t rsc,
+          std::ptrdiff_t csc) {
+  BlockedGemm(m, n, k, a, rsa, csa, b, rsb, csb, c, rsc, csc);
+}
+
+void Gemm(int m, int n, int k, const std::complex<double>* a,
+          std::ptrdiff_t rsa, std::ptrdiff_t csa,
+          const std::complex<double>* b, std::ptrdiff_t rsb,
+          std::ptrdiff_t csb, std::complex<double>* c, std::ptrdiff_t rsc,
+          std::ptrdiff_t csc) {
+  BlockedGemm(m, n, k, a, rsa, csa, b, rsb, csb, c, rsc, csc);
+}
+
+}  // namespace s21
@@ -0,0 +1,48 @@
+#ifndef S21_GEMM_H_
+#define S21_GEMM_H_
+
+#include <complex>
+#include <cstddef>
+
+namespace s21 {
+
+// Register tile of the micro-kernel: kGemmMr x kGemmNr accumulators of C.
+constexpr int kGemmMr = 4;
+constexpr int kGemmNr = 8;
+
+// Cache blocking: a kGemmKc x kGemmNr micro-panel of B stays in L1, a
+// kGemmMc x kGemmKc block of A stays in L2 and a kGemmKc x kGemmNc panel of
+// B stays in L3.
+constexpr int kGemmKc = 256;
+constexpr int kGemmMc = 96;
+constexpr int kGemmNc = 4080;
+
+// C += alpha * A * B, where A is m x k, B is k x n and C is m x n. Every
+// operand is described by a pointer and its row and column strides in
+// elements. alpha scales A while it is packed, so an alpha of -1 subtracts
+// the product at no extra cost.
+void Gemm(int m, int n, int k, const double* a, std::ptrdiff_t rsa,
+          std::ptrdiff_t csa, const double* b, std::ptrdiff_t rsb,
+          std::ptrdiff_t csb, double* c, std::ptrdiff_t rsc,
+          std::ptrdiff_t csc, double alpha = 1.0);
+// The other element types of S21BasicMatrix take the same blocked path. The
+// float micro-kernel is vectorized like the double one, long double and
+// complex ones are scalar. Complex products use the textbook formula, not
+// the infinity recovery of C Annex G: (inf + inf i) * 1 is NaN.
+void Gemm(int m, int n, int k, const float* a, std::ptrdiff_t rsa,
+          std::ptrdiff_t csa, const float* b, std::ptrdiff_t rsb,
+          std::ptrdiff_t csb, float* c, std::ptrdiff_t rsc,
+          std::ptrdiff_t csc);
+void Gemm(int m, int n, int k, const long double* a, std::ptrdiff_t rsa,
+          std::ptrdiff_t csa, const long double* b, std::ptrdiff_t rsb,
+          std::ptrdiff_t csb, long double* c, std::ptrdiff_t rsc,
+          std::ptrdiff_t csc);
+void Gemm(int m, int n, int k, const std::complex<double>* a,
+          std::ptrdiff_t rsa, std::ptrdiff_t csa,
+          const std::complex<double>* b, std::ptrdiff_t rsb,
+          std::ptrdiff_t csb, std::complex<double>* c, std::ptrdiff_t rsc,
+          std::ptrdiff_t csc);
+
+}  // namespace s21
+
+#endif  // S21_GEMM_H_
@@ -0,0 +1,50 @@
+#ifndef S21_INSTRUMENT_H_
+#define S21_INSTRUMENT_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "s21_matrix_stats.h"
+
+namespace s21 {
+
+#ifdef S21_MATRIX_INSTRUMENT
+
+// Counts one call of an operation over its lifetime: the elements it was
+// given, the allocations CountAllocation reports on this thread meanwhile,
+// and the time until it is destroyed.
+class OperationScope {
+ public:
+  OperationScope(S21MatrixStats::Operation operation,
+                 std::size_t elements) noexcept;
+  OperationScope(const OperationScope&) = delete;
+  OperationScope& operator=(const OperationScope&) = delete;
+  ~OperationScope(void);
+
+ private:
+  int operation_;
+  std::uint64_t elements_;
+  std::uint64_t allocations_;
+  std::uint64_t bytes_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+void CountAllocation(std::size_t bytes) noexcept;
+
+#else
+
+class OperationScope {
+ public:
+  OperationScope(S21MatrixStats::Operation, std::size_t) noexcept {}
+  OperationScope(const OperationScope&) = delete;
+  OperationScope& operator=(const OperationScope&) = delete;
+};
+
+inline void CountAllocation(std::size_t) noexcept {}
+
+#endif  // S21_MATRIX_INSTRUMENT
+
+}  // namespace s21
+
+#endif  // S21_INSTRUMENT_H_
@@ -0,0 +1,726 @@
+#include "s21_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define S21_KERNELS_X86 1
+#endif
+
+namespace s21 {
+
+namespace {
+
+template <typename T>
+struct Kernels {
+  void (*add)(T*, const T*, std::size_t);
+  void (*sub)(T*, const T*, std::size_t);
+  void (*scale)(T*, T, std::size_t);
+  void (*axpy)(T*, T, const T*, std::size_t);
+  bool (*equal)(const T*, const T*, std::size_t, T, T);
+};
+
+struct KernelTable {
+  SimdLevel level;
+  Kernels<double> f64;
+  Kernels<float> f32;
+};
+
+// The scalar loops serve every element type: they are the tails of the
+// vector kernels and the only kernels of long double and complex elements.
+template <typename T>
+void AddScalar(T* dst, const T* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] += src[i];
+  }
+}
+
+template <typename T>
+void SubScalar(T* dst, const T* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] -= src[i];
+  }
+}
+
+template <typename T>
+void ScaleScalar(T* dst, T factor, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] *= factor;
+  }
+}
+
+template <typename T>
+void AxpyScalar(T* dst, T factor, const T* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] += factor * src[i];
+  }
+}
+
+// eps and relative have the type of |a[i] - b[i]|, which is double for
+// complex elements. The relative part scales the smaller magnitude, so an
+// infinity never matches a finite number. A NaN scale leaves eps, here and
+// in the vector kernels, whose max returns its second operand then.
+template <typename T>
+bool EqualScalar(const T* a, const T* b, std::size_t n,
+                 decltype(std::abs(T())) eps,
+                 decltype(std::abs(T())) relative) {
+  bool result = true;
+  for (std::size_t i = 0; result && i < n; ++i) {
+    decltype(std::abs(T())) tolerance =
+        std::max(eps, relative * std::min(std::abs(a[i]), std::abs(b[i])));
+    if (std::abs(a[i] - b[i]) > tolerance) {
+      result = false;
+    }
+  }
+
+  return (result);
+}
+
+const KernelTable kScalarTable = {
+    SimdLevel::kScalar,
+    {AddScalar, SubScalar, ScaleScalar, AxpyScalar, EqualScalar},
+    {AddScalar, SubScalar, ScaleScalar, AxpyScalar, EqualScalar}};
+
+#ifdef S21_KERNELS_X86
+
+// SSE2 is part of the x86-64 baseline, so these need no target attribute.
+
+void AddSse2(double* dst, const double* src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128d d = _mm_loadu_pd(dst + i);
+    _mm_storeu_pd(dst + i, _mm_add_pd(d, _mm_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+void SubSse2(double* dst, const double* src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128d d = _mm_loadu_pd(dst + i);
+    _mm_storeu_pd(dst + i, _mm_sub_pd(d, _mm_loadu_pd(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+void ScaleSse2(double* dst, double factor, std::size_t n) {
+  __m128d f = _mm_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_loadu_pd(dst + i), f));
+  }
+  ScaleScalar(dst + i, factor, n - i);
+}
+
+void AxpySse2(double* dst, double factor, const double* src, std::size_t n) {
+  __m128d f = _mm_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128d product = _mm_mul_pd(f, _mm_loadu_pd(src + i));
+    _mm_storeu_pd(dst + i, _mm_add_pd(_mm_loadu_pd(dst + i), product));
+  }
+  AxpyScalar(dst + i, factor, src + i, n - i);
+}
+
+bool EqualSse2(const double* a, const double* b, std::size_t n, double eps,
+               double relative) {
+  __m128d e = _mm_set1_pd(eps);
+  __m128d r = _mm_set1_pd(relative);
+  __m128d sign = _mm_set1_pd(-0.0);
+  std::size_t i = 0;
+  bool result = true;
+  for (; result && i + 2 <= n; i += 2) {
+    __m128d x = _mm_loadu_pd(a + i);
+    __m128d y = _mm_loadu_pd(b + i);
+    __m128d diff = _mm_andnot_pd(sign, _mm_sub_pd(x, y));
+    __m128d scale =
+        _mm_min_pd(_mm_andnot_pd(sign, x), _mm_andnot_pd(sign, y));
+    __m128d tolerance = _mm_max_pd(_mm_mul_pd(r, scale), e);
+    if (_mm_movemask_pd(_mm_cmpgt_pd(diff, tolerance)) != 0) {
+      result = false;
+    }
+  }
+
+  return (result && EqualScalar(a + i, b + i, n - i, eps, relative));
+}
+
+void AddSse2(float* dst, const float* src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 d = _mm_loadu_ps(dst + i);
+    _mm_storeu_ps(dst + i, _mm_add_ps(d, _mm_loadu_ps(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+void SubSse2(float* dst, const float* src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 d = _mm_loadu_ps(dst + i);
+    _mm_storeu_ps(dst + i, _mm_sub_ps(d, _mm_loadu_ps(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+void ScaleSse2(float* dst, float factor, std::size_t n) {
+  __m128 f = _mm_set1_ps(factor);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), f));
+  }
+  ScaleScalar(dst + i, factor, n - i);
+}
+
+void AxpySse2(float* dst, float factor, const float* src, std::size_t n) {
+  __m128 f = _mm_set1_ps(factor);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 product = _mm_mul_ps(f, _mm_loadu_ps(src + i));
+    _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), product));
+  }
+  AxpyScalar(dst + i, factor, src + i, n - i);
+}
+
+bool EqualSse2(const float* a, const float* b, std::size_t n, float eps,
+               float relative) {
+  __m128 e = _mm_set1_ps(eps);
+  __m128 r = _mm_set1_ps(relative);
+  __m128 sign = _mm_set1_ps(-0.0f);
+  std::size_t i = 0;
+  bool result = true;
+  for (; result && i + 4 <= n; i += 4) {
+    __m128 x = _mm_loadu_ps(a + i);
+    __m128 y = _mm_loadu_ps(b + i);
+    __m128 diff = _mm_andnot_ps(sign, _mm_sub_ps(x, y));
+    __m128 scale =
+        _mm_min_ps(_mm_andnot_ps(sign, x), _mm_andnot_ps(sign, y));
+    __m128 tolerance = _mm_max_ps(_mm_mul_ps(r, scale), e);
+    if (_mm_movemask_ps(_mm_cmpgt_ps(diff, tolerance)) != 0) {
+      result = false;
+    }
+  }
+
+  return (result && EqualScalar(a + i, b + i, n - i, eps, relative));
+}
+
+const KernelTable kSse2Table = {
+    SimdLevel::kSse2,
+    {AddSse2, SubSse2, ScaleSse2, AxpySse2, EqualSse2},
+    {AddSse2, SubSse2, ScaleSse2, AxpySse2, EqualSse2}};
+
+__attribute__((target("avx2"))) void AddAvx2(double* dst, const double* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d d = _mm256_loadu_pd(dst + i);
+    _mm256_storeu_pd(dst + i, _mm256_add_pd(d, _mm256_loadu_pd(src + i)));
+  }
+  AddSse2(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(double* dst, const double* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d d = _mm256_loadu_pd(dst + i);
+    _mm256_storeu_pd(dst + i, _mm256_sub_pd(d, _mm256_loadu_pd(src + i)));
+  }
+  SubSse2(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(double* dst, double factor,
+                                               std::size_t n) {
+  __m256d f = _mm256_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_loadu_pd(dst + i), f));
+  }
+  ScaleSse2(dst + i, factor, n - i);
+}
+
+__attribute__((target("avx2"))) void AxpyAvx2(double* dst, double factor,
+                                              const double* src,
+                                              std::size_t n) {
+  __m256d f = _mm256_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d product = _mm256_mul_pd(f, _mm256_loadu_pd(src + i));
+    _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(dst + i), product));
+  }
+  AxpySse2(dst + i, factor, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) bool EqualAvx2(const double* a,
+                                               const double* b, std::size_t n,
+                                               double eps, double relative) {
+  __m256d e = _mm256_set1_pd(eps);
+  __m256d r = _mm256_set1_pd(relative);
+  __m256d sign = _mm256_set1_pd(-0.0);
+  std::size_t i = 0;
+  bool result = true;
+  for (; result && i + 4 <= n; i += 4) {
+    __m256d x = _mm256_loadu_pd(a + i);
+    __m256d y = _mm256_loadu_pd(b + i);
+    __m256d diff = _mm256_andnot_pd(sign, _mm256_sub_pd(x, y));
+    __m256d scale = _mm256_min_pd(_mm256_andnot_pd(sign, x),
+                                  _mm256_andnot_pd(sign, y));
+    __m256d tolerance = _mm256_max_pd(_mm256_mul_pd(r, scale), e);
+    if (_mm256_movemask_pd(_mm256_cmp_pd(diff, tolerance, _CMP_GT_OQ)) != 0) {
+      result = false;
+    }
+  }
+
+  return (result && EqualSse2(a + i, b + i, n - i, eps, relative));
+}
+
+__attribute__((target("avx2"))) void AddAvx2(float* dst, const float* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 d = _mm256_loadu_ps(dst + i);
+    _mm256_storeu_ps(dst + i, _mm256_add_ps(d, _mm256_loadu_ps(src + i)));
+  }
+  AddSse2(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(float* dst, const float* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 d = _mm256_loadu_ps(dst + i);
+    _mm256_storeu_ps(dst + i, _mm256_sub_ps(d, _mm256_loadu_ps(src + i)));
+  }
+  SubSse2(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(float* dst, float factor,
+                                               std::size_t n) {
+  __m256 f = _mm256_set1_ps(factor);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(dst + i), f));
+  }
+  ScaleSse2(dst + i, factor, n - i);
+}
+
+__attribute__((target("avx2"))) void AxpyAvx2(float* dst, float factor,
+                                              const float* src,
+                                              std::size_t n) {
+  __m256 f = _mm256_set1_ps(factor);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 product = _mm256_mul_ps(f, _mm256_loadu_ps(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), product));
+  }
+  AxpySse2(dst + i, factor, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) bool EqualAvx2(const float* a, const float* b,
+                                               std::size_t n, float eps,
+                                               float relative) {
+  __m256 e = _mm256_set1_ps(eps);
+  __m256 r = _mm256_set1_ps(relative);
+  __m256 sign = _mm256_set1_ps(-0.0f);
+  std::size_t i = 0;
+  bool result = true;
+  for (; result && i + 8 <= n; i += 8) {
+    __m256 x = _mm256_loadu_ps(a + i);
+    __m256 y = _mm256_loadu_ps(b + i);
+    __m256 diff = _mm256_andnot_ps(sign, _mm256_sub_ps(x, y));
+    __m256 scale =
+        _mm256_min_ps(_mm256_andnot_ps(sign, x), _mm256_andnot_ps(sign, y));
+    __m256 tolerance = _mm256_max_ps(_mm256_mul_ps(r, scale), e);
+    if (_mm256_movemask_ps(_mm256_cmp_ps(diff, tolerance, _CMP_GT_OQ)) != 0) {
+      result = false;
+    }
+  }
+
+  return (result && EqualSse2(a + i, b + i, n - i, eps, relative));
+}
+
+const KernelTable kAvx2Table = {
+    SimdLevel::kAvx2,
+    {AddAvx2, SubAvx2, ScaleAvx2, AxpyAvx2, EqualAvx2},
+    {AddAvx2, SubAvx2, ScaleAvx2, AxpyAvx2, EqualAvx2}};
+
+// The AVX-512 variants finish the tail with a masked operation instead of
+// falling back to a narrower kernel.
+
+__attribute__((target("avx512f"))) void AddAvx512(double* dst,
+                                                  const double* src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m512d d = _mm512_loadu_pd(dst + i);
+    _mm512_storeu_pd(dst + i, _mm512_add_pd(d, _mm512_loadu_pd(src + i)));
+  }
+  if (i < n) {
+    __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+    __m512d d = _mm512_maskz_loadu_pd(mask, dst + i);
+    __m512d s = _mm512_maskz_loadu_pd(mask, src + i);
+    _mm512_mask_storeu_pd(dst + i, mask, _mm512_add_pd(d, s));
+  }
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(double* dst,
+                                                  const double* src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m512d d = _mm512_loadu_pd(dst + i);
+    _mm512_storeu_pd(dst + i, _mm512_sub_pd(d, _mm512_loadu_pd(src + i)));
+  }
+  if (i < n) {
+    __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+    __m512d d = _mm512_maskz_loadu_pd(mask, dst + i);
+    __m512d s = _mm512_maskz_loadu_pd(mask, src + i);
+    _mm512_mask_storeu_pd(dst + i, mask, _mm512_sub_pd(d, s));
+  }
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(double* dst,
+                                                    double factor,
+                                                    std::size_t n) {
+  __m512d f = _mm512_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_mul_pd(_mm512_loadu_pd(dst + i), f));
+  }
+  if (i < n) {
+    __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+    __m512d d = _mm512_maskz_loadu_pd(mask, dst + i);
+    _mm512_mask_storeu_pd(dst + i, mask, _mm512_mul_pd(d, f));
+  }
+}
+
+__attribute__((target("avx512f"))) void AxpyAvx512(double* dst,
+                                                   double factor,
+                                                   const double* src,
+                                                   std::size_t n) {
+  __m512d f = _mm512_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m512d product = _mm512_mul_pd(f, _mm512_loadu_pd(src + i));
+    _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(dst + i), product));
+  }
+  if (i < n) {
+    __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+    __m512d product = _mm512_mul_pd(f, _mm512_maskz_loadu_pd(mask, src + i));
+    __m512d d = _mm512_maskz_loadu_pd(mask, dst + i);
+    _mm512_mask_storeu_pd(dst + i, mask, _mm512_add_pd(d, product));
+  }
+}
+
+// The lanes where diff exceeds e and one of rx and ry, so exceeds the larger
+// of e and the smaller of rx and ry, as in EqualScalar. The compares stand in
+// for max and min, whose unmasked AVX-512 forms GCC 12 flags as reading an
+// uninitialized value.
+__attribute__((target("avx512f"))) __mmask8 Exceeds(__m512d diff, __m512d e,
+                                                    __m512d rx, __m512d ry) {
+  __mmask8 mask = _mm512_cmp_pd_mask(diff, rx, _CMP_GT_OQ) |
+                  _mm512_cmp_pd_mask(diff, ry, _CMP_GT_OQ);
+  return (_mm512_mask_cmp_pd_mask(mask, diff, e, _CMP_GT_OQ));
+}
+
+__attribute__((target("avx512f"))) __mmask16 Exceeds(__m512 diff, __m512 e,
+                                                     __m512 rx, __m512 ry) {
+  __mmask16 mask = _mm512_cmp_ps_mask(diff, rx, _CMP_GT_OQ) |
+                   _mm512_cmp_ps_mask(diff, ry, _CMP_GT_OQ);
+  return (_mm512_mask_cmp_ps_mask(mask, diff, e, _CMP_GT_OQ));
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const double* a,
+                                                    const double* b,
+                                                    std::size_t n,
+                                                    double eps,
+                                                    double relative) {
+  __m512d e = _mm512_set1_pd(eps);
+  __m512d r = _mm512_set1_pd(relative);
+  std::size_t i = 0;
+  bool result = true;
+  for (; result && i + 8 <= n; i += 8) {
+    __m512d x = _mm512_loadu_pd(a + i);
+    __m512d y = _mm512_loadu_pd(b + i);
+    __m512d diff = _mm512_abs_pd(_mm512_sub_pd(x, y));
+    if (Exceeds(diff, e, _mm512_mul_pd(r, _mm512_abs_pd(x)),
+                _mm512_mul_pd(r, _mm512_abs_pd(y))) != 0) {
+      result = false;
+    }
+  }
+  if (result && i < n) {
+    __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+    __m512d x = _mm512_maskz_loadu_pd(mask, a + i);
+    __m512d y = _mm512_maskz_loadu_pd(mask, b + i);
+    __m512d diff = _mm512_abs_pd(_mm512_sub_pd(x, y));
+    if (Exceeds(diff, e, _mm512_mul_pd(r, _mm512_abs_pd(x)),
+                _mm512_mul_pd(r, _mm512_abs_pd(y))) != 0) {
+      result = false;
+    }
+  }
+
+  return (result);
+}
+
+__attribute__((target("avx512f"))) void AddAvx512(float* dst,
+                                                  const float* src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512 d = _mm512_loadu_ps(dst + i);
+    _mm512_storeu_ps(dst + i, _mm512_add_ps(d, _mm512_loadu_ps(src + i)));
+  }
+  if (i < n) {
+    __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1u);
+    __m512 d = _mm512_maskz_loadu_ps(mask, dst + i);
+    __m512 s = _mm512_maskz_loadu_ps(mask, src + i);
+    _mm512_mask_storeu_ps(dst + i, mask, _mm512_add_ps(d, s));
+  }
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(float* dst,
+                                                  const float* src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512 d = _mm512_loadu_ps(dst + i);
+    _mm512_storeu_ps(dst + i, _mm512_sub_ps(d, _mm512_loadu_ps(src + i)));
+  }
+  if (i < n) {
+    __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1u);
+    __m512 d = _mm512_maskz_loadu_ps(mask, dst + i);
+    __m512 s = _mm512_maskz_loadu_ps(mask, src + i);
+    _mm512_mask_storeu_ps(dst + i, mask, _mm512_sub_ps(d, s));
+  }
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(float* dst, float factor,
+                                                    std::size_t n) {
+  __m512 f = _mm512_set1_ps(factor);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_loadu_ps(dst + i), f));
+  }
+  if (i < n) {
+    __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1u);
+    __m512 d = _mm512_maskz_loadu_ps(mask, dst + i);
+    _mm512_mask_storeu_ps(dst + i, mask, _mm512_mul_ps(d, f));
+  }
+}
+
+__attribute__((target("avx512f"))) void AxpyAvx512(float* dst, float factor,
+                                                   const float* src,
+                                                   std::size_t n) {
+  __m512 f = _mm512_set1_ps(factor);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512 product = _mm512_mul_ps(f, _mm512_loadu_ps(src + i));
+    _mm512_storeu_ps(dst + i, _mm512_add_ps(_mm512_loadu_ps(dst + i), product));
+  }
+  if (i < n) {
+    __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1u);
+    __m512 product = _mm512_mul_ps(f, _mm512_maskz_loadu_ps(mask, src + i));
+    __m512 d = _mm512_maskz_loadu_ps(mask, dst + i);
+    _mm512_mask_storeu_ps(dst + i, mask, _mm512_add_ps(d, product));
+  }
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const float* a,
+                                                    const float* b,
+                                                    std::size_t n, float eps,
+                                                    float relative) {
+  __m512 e = _mm512_set1_ps(eps);
+  __m512 r = _mm512_set1_ps(relative);
+  std::size_t i = 0;
+  bool result = true;
+  for (; result && i + 16 <= n; i += 16) {
+    __m512 x = _mm512_loadu_ps(a + i);
+    __m512 y = _mm512_loadu_ps(b + i);
+    __m512 diff = _mm512_abs_ps(_mm512_sub_ps(x, y));
+    if (Exceeds(diff, e, _mm512_mul_ps(r, _mm512_abs_ps(x)),
+                _mm512_mul_ps(r, _mm512_abs_ps(y))) != 0) {
+      result = false;
+    }
+  }
+  if (result && i < n) {
+    __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1u);
+    __m512 x = _mm512_maskz_loadu_ps(mask, a + i);
+    __m512 y = _mm512_maskz_loadu_ps(mask, b + i);
+    __m512 diff = _mm512_abs_ps(_mm512_sub_ps(x, y));
+    if (Exceeds(diff, e, _mm512_mul_ps(r, _mm512_abs_ps(x)),
+                _mm512_mul_ps(r, _mm512_abs_ps(y))) != 0) {
+      result = false;
+    }
+  }
+
+  return (result);
+}
+
+const KernelTable kAvx512Table = {
+    SimdLevel::kAvx512,
+    {AddAvx512, SubAvx512, ScaleAvx512, AxpyAvx512, EqualAvx512},
+    {AddAvx512, SubAvx512, ScaleAvx512, AxpyAvx512, EqualAvx512}};
+
+#endif  // S21_KERNELS_X86
+
+const KernelTable* TableFor(SimdLevel level) noexcept {
+  const KernelTable* table = &kScalarTable;
+#ifdef S21_KERNELS_X86
+  if (level == SimdLevel::kAvx512) {
+    table = &kAvx512Table;
+  } else if (level == SimdLevel::kAvx2) {
+    table = &kAvx2Table;
+  } else if (level == SimdLevel::kSse2) {
+    table = &kSse2Table;
+  }
+#else
+  (void)level;
+#endif
+
+  return (table);
+}
+
+std::atomic<const KernelTable*> active_table{nullptr};
+
+const KernelTable& ActiveTable(void) noexcept {
+  const KernelTable* table = active_table.load(std::memory_order_acquire);
+  if (table == nullptr) {
+    table = TableFor(DetectSimdLevel());
+    active_table.store(table, std::memory_order_release);
+  }
+
+  return (*table);
+}
+
+}  // namespace
+
+// __builtin_cpu_supports reads cpuid once at startup and also checks that
+// the operating system saves the wide vector registers.
+SimdLevel DetectSimdLevel(void) noexcept {
+  SimdLevel level = SimdLevel::kScalar;
+#ifdef S21_KERNELS_X86
+  if (__builtin_cpu_supports("avx512f")) {
+    level = SimdLevel::kAvx512;
+  } else if (__builtin_cpu_supports("avx2")) {
+    level = SimdLevel::kAvx2;
+  } else if (__builtin_cpu_supports("sse2")) {
+    level = SimdLevel::kSse2;
+  }
+#endif
+
+  return (level);
+}
+
+SimdLevel ActiveSimdLevel(void) noexcept { return (ActiveTable().level); }
+
+SimdLevel SetSimdLevel(SimdLevel level) noexcept {
+  SimdLevel supported = DetectSimdLevel();
+  if (static_cast<int>(level) > static_cast<int>(supported)) {
+    level = supported;
+  }
+  active_table.store(TableFor(level), std::memory_order_release);
+
+  return (level);
+}
+
+void AddKernel(double* dst, const double* src, std::size_t n) noexcept {
+  ActiveTable().f64.add(dst, src, n);
+}
+
+void SubKernel(double* dst, const double* src, std::size_t n) noexcept {
+  ActiveTable().f64.sub(dst, src, n);
+}
+
+void ScaleKernel(double* dst, double factor, std::size_t n) noexcept {
+  ActiveTable().f64.scale(dst, factor, n);
+}
+
+void AxpyKernel(double* dst, double factor, const double* src,
+                std::size_t n) noexcept {
+  ActiveTable().f64.axpy(dst, factor, src, n);
+}
+
+bool EqualKernel(const double* a, const double* b, std::size_t n,
+                 double eps, double relative) noexcept {
+  return (ActiveTable().f64.equal(a, b, n, eps, relative));
+}
+
+void AddKernel(float* dst, const float* src, std::size_t n) noexcept {
+  ActiveTable().f32.add(dst, src, n);
+}
+
+void SubKernel(float* dst, const float* src, std::size_t n) noexcept {
+  ActiveTable().f32.sub(dst, src, n);
+}
+
+void ScaleKernel(float* dst, float factor, std::size_t n) noexcept {
+  ActiveTable().f32.scale(dst, factor, n);
+}
+
+void AxpyKernel(float* dst, float factor, const float* src,
+                std::size_t n) noexcept {
+  ActiveTable().f32.axpy(dst, factor, src, n);
+}
+
+bool EqualKernel(const float* a, const float* b, std::size_t n,
+                 double eps, double relative) noexcept {
+  return (ActiveTable().f32.equal(a, b, n, static_cast<float>(eps),
+                                  static_cast<float>(relative)));
+}
+
+void AddKernel(long double* dst, const long double* src,
+               std::size_t n) noexcept {
+  AddScalar(dst, src, n);
+}
+
+void SubKernel(long double* dst, const long double* src,
+               std::size_t n) noexcept {
+  SubScalar(dst, src, n);
+}
+
+void ScaleKernel(long double* dst, long double factor,
+                 std::size_t n) noexcept {
+  ScaleScalar(dst, factor, n);
+}
+
+void AxpyKernel(long double* dst, long double factor, const long double* src,
+                std::size_t n) noexcept {
+  AxpyScalar(dst, factor, src, n);
+}
+
+bool EqualKernel(const long double* a, const long double* b, std::size_t n,
+                 double eps, double relative) noexcept {
+  return (EqualScalar<long double>(a, b, n, eps, relative));
+}
+
+// std::complex<double> is laid out as two doubles, real part first.
+void AddKernel(std::complex<double>* dst, const std::complex<double>* src,
+               std::size_t n) noexcept {
+  AddKernel(reinterpret_cast<double*>(dst),
+            reinterpret_cast<const double*>(src), 2 * n);
+}
+
+void SubKernel(std::complex<double>* dst, const std::complex<double>* src,
+               std::size_t n) noexcept {
+  SubKernel(reinterpret_cast<double*>(dst),
+            reinterpret_cast<const double*>(src), 2 * n);
+}
+
+void ScaleKernel(std::complex<double>* dst, std::complex<double> factor,
+                 std::size_t n) noexcept {
+  ScaleScalar(dst, factor, n);
+}
+
+void AxpyKernel(std::complex<double>* dst, std::complex<double> factor,
+                const std::complex<double>* src, std::size_t n) noexcept {
+  AxpyScalar(dst, factor, src, n);
+}
+
+bool EqualKernel(const std::complex<double>* a,
+                 const std::complex<double>* b, std::size_t n,
+                 double eps, double relative) noexcept {
+  return (EqualScalar(a, b, n, eps, relative));
+}
+
+}  // namespace s21
@@ -0,0 +1,72 @@
+#ifndef S21_KERNELS_H_
+#define S21_KERNELS_H_
+
+#include <complex>
+#include <cstddef>
+
+namespace s21 {
+
+// Instruction set used by the element-wise kernels. Every level is compiled
+// into the library; the widest one supported by the host CPU and operating
+// system is picked the first time a kernel runs.
+enum class SimdLevel { kScalar, kSse2, kAvx2, kAvx512 };
+
+SimdLevel DetectSimdLevel(void) noexcept;
+SimdLevel ActiveSimdLevel(void) noexcept;
+// Switches the kernels to the given level, clamped to what the host
+// supports, and returns the level actually selected.
+SimdLevel SetSimdLevel(SimdLevel level) noexcept;
+
+// dst[i] += src[i]
+void AddKernel(double* dst, const double* src, std::size_t n) noexcept;
+// dst[i] -= src[i]
+void SubKernel(double* dst, const double* src, std::size_t n) noexcept;
+// dst[i] *= factor
+void ScaleKernel(double* dst, double factor, std::size_t n) noexcept;
+// dst[i] += factor * src[i], rounded like the scalar expression.
+void AxpyKernel(double* dst, double factor, const double* src,
+                std::size_t n) noexcept;
+// True when no |a[i] - b[i]| is greater than eps or, when that is larger,
+// relative times the smaller of |a[i]| and |b[i]|.
+bool EqualKernel(const double* a, const double* b, std::size_t n,
+                 double eps, double relative = 0.0) noexcept;
+
+// The same kernels for the other element types of S21BasicMatrix. The float
+// ones are vectorized like the double ones, four or eight lanes wider; long
+// double has no vector instructions and runs scalar loops. Complex sums and
+// differences run the double kernels over the real and imaginary parts.
+void AddKernel(float* dst, const float* src, std::size_t n) noexcept;
+void SubKernel(float* dst, const float* src, std::size_t n) noexcept;
+void ScaleKernel(float* dst, float factor, std::size_t n) noexcept;
+void AxpyKernel(float* dst, float factor, const float* src,
+                std::size_t n) noexcept;
+bool EqualKernel(const float* a, const float* b, std::size_t n,
+                 double eps, double relative = 0.0) noexcept;
+
+void AddKernel(long double* dst, const long double* src,
+               std::size_t n) noexcept;
+void SubKernel(long double* dst, const long double* src,
+               std::size_t n) noexcept;
+void ScaleKernel(long double* dst, long double factor,
+                 std::size_t n) noexcept;
+void AxpyKernel(long double* dst, long double factor, const long double* src,
+                std::size_t n) noexcept;
+bool EqualKernel(const long double* a, const long double* b, std::size_t n,
+                 double eps, double relative = 0.0) noexcept;
+
+void AddKernel(std::complex<double>* dst, const std::complex<double>* src,
+               std::size_t n) noexcept;
+void SubKernel(std::complex<double>* dst, const std::complex<double>* src,
+               std::size_t n) noexcept;
+void ScaleKernel(std::complex<double>* dst, std::complex<double> factor,
+                 std::size_t n) noexcept;
+void AxpyKernel(std::complex<double>* dst, std::complex<double> factor,
+                const std::complex<double>* src, std::size_t n) noexcept;
+// Compares the moduli of the differences.
+bool EqualKernel(const std::complex<double>* a,
+                 const std::complex<double>* b, std::size_t n,
+                 double eps, double relative = 0.0) noexcept;
+
+}  // namespace s21
+
+#endif  // S21_KERNELS_H_
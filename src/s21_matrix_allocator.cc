@@ -0,0 +1,297 @@
+#include "s21_matrix_allocator.h"
+
+#include <algorithm>
+#include <new>
+
+const std::size_t S21MatrixAllocator::kAlignment = 64;
+const std::size_t S21MatrixAllocator::kPoolMaxBytes = std::size_t(4) << 20;
+const std::size_t S21MatrixArena::kDefaultBlockSize = std::size_t(1) << 20;
+
+namespace {
+
+// Size classes of the pool are the powers of two from 128 bytes, the
+// smallest matrix that is not stored inline, to kPoolMaxBytes. Each thread
+// caches at most kPoolClassBlocks blocks and kPoolClassBytes bytes of a
+// class.
+const int kPoolMinShift = 7;
+const int kPoolClasses = 16;
+const std::size_t kPoolClassBlocks = 32;
+const std::size_t kPoolClassBytes = std::size_t(8) << 20;
+
+thread_local S21MatrixAllocator* current_allocator = nullptr;
+
+void* SystemAllocate(std::size_t bytes) {
+  return (::operator new(bytes,
+                         std::align_val_t(S21MatrixAllocator::kAlignment)));
+}
+
+void SystemDeallocate(void* ptr) noexcept {
+  ::operator delete(ptr, std::align_val_t(S21MatrixAllocator::kAlignment));
+}
+
+class SystemAllocator : public S21MatrixAllocator {
+ public:
+  void* Allocate(std::size_t bytes) override {
+    void* ptr = SystemAllocate(bytes);
+    CountAllocation(bytes);
+    CountSystemAllocation(bytes);
+
+    return (ptr);
+  }
+
+  void Deallocate(void* ptr, std::size_t bytes) noexcept override {
+    SystemDeallocate(ptr);
+    CountDeallocation(bytes);
+    CountSystemDeallocation(bytes);
+  }
+};
+
+int SizeClass(std::size_t bytes) noexcept {
+  int size_class = 0;
+  while ((std::size_t(1) << (size_class + kPoolMinShift)) < bytes) {
+    ++size_class;
+  }
+
+  return (size_class);
+}
+
+std::size_t ClassSize(int size_class) noexcept {
+  return (std::size_t(1) << (size_class + kPoolMinShift));
+}
+
+class PoolAllocator;
+
+// The free lists of one thread. Blocks freed on another thread than the one
+// that allocated them join the lists of the freeing thread.
+class ThreadCache {
+ public:
+  explicit ThreadCache(PoolAllocator& pool);
+  ~ThreadCache(void);
+
+  std::vector<void*> blocks[kPoolClasses];
+
+ private:
+  PoolAllocator& pool_;
+};
+
+// Set while the calling thread has a live cache. A thread gets its cache
+// on its first pooled allocation; after the cache is destroyed at thread
+// exit, blocks go straight back to the system.
+thread_local ThreadCache* thread_cache = nullptr;
+thread_local bool thread_cache_destroyed = false;
+
+class PoolAllocator : public S21MatrixAllocator {
+ public:
+  void* Allocate(std::size_t bytes) override {
+    void* ptr = nullptr;
+    if (bytes > kPoolMaxBytes) {
+      ptr = SystemAllocate(bytes);
+      CountSystemAllocation(bytes);
+    } else {
+      int size_class = SizeClass(bytes);
+      ThreadCache* cache = LocalCache();
+      if (cache != nullptr && !cache->blocks[size_class].empty()) {
+        ptr = cache->blocks[size_class].back();
+        cache->blocks[size_class].pop_back();
+      } else {
+        ptr = SystemAllocate(ClassSize(size_class));
+        CountSystemAllocation(ClassSize(size_class));
+      }
+    }
+    CountAllocation(bytes);
+
+    return (ptr);
+  }
+
+  void Deallocate(void* ptr, std::size_t bytes) noexcept override {
+    CountDeallocation(bytes);
+    if (bytes > kPoolMaxBytes) {
+      Release(ptr, bytes);
+    } else {
+      int size_class = SizeClass(bytes);
+      std::vector<void*>* blocks =
+          thread_cache == nullptr ? nullptr : &thread_cache->blocks[size_class];
+      if (blocks != nullptr && blocks->size() < blocks->capacity()) {
+        blocks->push_back(ptr);
+      } else {
+        Release(ptr, ClassSize(size_class));
+      }
+    }
+  }
+
+  void Release(void* ptr, std::size_t bytes) noexcept {
+    SystemDeallocate(ptr);
+    CountSystemDeallocation(bytes);
+  }
+
+ private:
+  ThreadCache* LocalCache(void) {
+    if (thread_cache == nullptr && !thread_cache_destroyed) {
+      thread_local ThreadCache cache(*this);
+    }
+
+    return (thread_cache);
+  }
+};
+
+// The capacity of a list is its limit, reserved up front so that freeing a
+// block never allocates.
+ThreadCache::ThreadCache(PoolAllocator& pool) : pool_(pool) {
+  for (int c = 0; c < kPoolClasses; ++c) {
+    blocks[c].reserve(
+        std::min(kPoolClassBlocks, std::max<std::size_t>(
+                                       1, kPoolClassBytes / ClassSize(c))));
+  }
+  thread_cache = this;
+}
+
+ThreadCache::~ThreadCache(void) {
+  thread_cache = nullptr;
+  thread_cache_destroyed = true;
+  for (int c = 0; c < kPoolClasses; ++c) {
+    for (void* ptr : blocks[c]) {
+      pool_.Release(ptr, ClassSize(c));
+    }
+  }
+}
+
+std::size_t RoundUp(std::size_t bytes) noexcept {
+  std::size_t alignment = S21MatrixAllocator::kAlignment;
+  return (std::max(alignment, (bytes + alignment - 1) / alignment * alignment));
+}
+
+}  // namespace
+
+// Allocator.
+
+S21MatrixAllocator::S21MatrixAllocator(void)
+    : allocations_(0),
+      deallocations_(0),
+      bytes_in_use_(0),
+      peak_bytes_in_use_(0),
+      system_allocations_(0),
+      bytes_reserved_(0) {}
+
+S21MatrixAllocator::~S21MatrixAllocator(void) {}
+
+S21MatrixAllocatorStats S21MatrixAllocator::stats(void) const noexcept {
+  S21MatrixAllocatorStats stats;
+  stats.allocations = allocations_.load(std::memory_order_relaxed);
+  stats.deallocations = deallocations_.load(std::memory_order_relaxed);
+  stats.bytes_in_use = bytes_in_use_.load(std::memory_order_relaxed);
+  stats.peak_bytes_in_use =
+      peak_bytes_in_use_.load(std::memory_order_relaxed);
+  stats.system_allocations =
+      system_allocations_.load(std::memory_order_relaxed);
+  stats.bytes_reserved = bytes_reserved_.load(std::memory_order_relaxed);
+
+  return (stats);
+}
+
+// Counters of memory that is still held, in use or reserved, keep their
+// values; the peak restarts from the current use.
+void S21MatrixAllocator::ResetStats(void) noexcept {
+  allocations_.store(0, std::memory_order_relaxed);
+  deallocations_.store(0, std::memory_order_relaxed);
+  system_allocations_.store(0, std::memory_order_relaxed);
+  peak_bytes_in_use_.store(bytes_in_use_.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+}
+
+S21MatrixAllocator& S21MatrixAllocator::System(void) noexcept {
+  static SystemAllocator allocator;
+  return (allocator);
+}
+
+S21MatrixAllocator& S21MatrixAllocator::Pool(void) noexcept {
+  static PoolAllocator allocator;
+  return (allocator);
+}
+
+S21MatrixAllocator& S21MatrixAllocator::Current(void) noexcept {
+  return (current_allocator == nullptr ? System() : *current_allocator);
+}
+
+void S21MatrixAllocator::CountAllocation(std::size_t bytes) noexcept {
+  allocations_.fetch_add(1, std::memory_order_relaxed);
+  std::size_t in_use =
+      bytes_in_use_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  std::size_t peak = peak_bytes_in_use_.load(std::memory_order_relaxed);
+  while (peak < in_use && !peak_bytes_in_use_.compare_exchange_weak(
+                              peak, in_use, std::memory_order_relaxed)) {
+  }
+}
+
+void S21MatrixAllocator::CountDeallocation(std::size_t bytes) noexcept {
+  deallocations_.fetch_add(1, std::memory_order_relaxed);
+  bytes_in_use_.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void S21MatrixAllocator::CountSystemAllocation(std::size_t bytes) noexcept {
+  system_allocations_.fetch_add(1, std::memory_order_relaxed);
+  bytes_reserved_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void S21MatrixAllocator::CountSystemDeallocation(std::size_t bytes) noexcept {
+  bytes_reserved_.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+// Scope.
+
+S21MatrixAllocatorScope::S21MatrixAllocatorScope(
+    S21MatrixAllocator& allocator) noexcept
+    : previous_(current_allocator) {
+  current_allocator = &allocator;
+}
+
+S21MatrixAllocatorScope::~S21MatrixAllocatorScope(void) {
+  current_allocator = previous_;
+}
+
+// Arena.
+
+S21MatrixArena::S21MatrixArena(std::size_t block_size)
+    : block_size_(RoundUp(block_size)),
+      block_(0),
+      offset_(0),
+      live_(0) {}
+
+S21MatrixArena::~S21MatrixArena(void) {
+  for (const Block& block : blocks_) {
+    SystemDeallocate(block.data);
+  }
+}
+
+void* S21MatrixArena::Allocate(std::size_t bytes) {
+  std::size_t size = RoundUp(bytes);
+  while (block_ < blocks_.size() && offset_ + size > blocks_[block_].size) {
+    ++block_;
+    offset_ = 0;
+  }
+  if (block_ == blocks_.size()) {
+    Block block = {nullptr, std::max(block_size_, size)};
+    blocks_.reserve(blocks_.size() + 1);
+    block.data = static_cast<char*>(SystemAllocate(block.size));
+    blocks_.push_back(block);
+    CountSystemAllocation(block.size);
+  }
+
+  void* ptr = blocks_[block_].data + offset_;
+  offset_ += size;
+  ++live_;
+  CountAllocation(bytes);
+
+  return (ptr);
+}
+
+void S21MatrixArena::Deallocate(void* ptr, std::size_t bytes) noexcept {
+  CountDeallocation(bytes);
+  std::size_t size = RoundUp(bytes);
+  if (--live_ == 0) {
+    block_ = 0;
+    offset_ = 0;
+  } else if (offset_ >= size &&
+             ptr == blocks_[block_].data + offset_ - size) {
+    offset_ -= size;
+  }
+}
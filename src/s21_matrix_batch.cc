@@ -0,0 +1,301 @@
+#include "s21_matrix_batch.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "s21_batch_kernels.h"
+#include "s21_kernels.h"
+
+const int S21MatrixBatch::kLanes = s21::kBatchLanes;
+
+// Constructors.
+
+S21MatrixBatch::S21MatrixBatch(int count, int rows, int cols, Layout layout)
+    : count_(count), rows_(rows), cols_(cols), layout_(layout) {
+  if (count < 1) {
+    throw std::invalid_argument("The number of matrices is less than 1.");
+  }
+  if (rows < 1) {
+    throw std::invalid_argument("The number of rows is less than 1.");
+  }
+  if (cols < 1) {
+    throw std::invalid_argument("The number of columns is less than 1.");
+  }
+
+  int matrices = layout == Layout::kSoa ? chunks() * kLanes : count;
+  data_.assign(static_cast<std::size_t>(matrices) * rows * cols, 0.0);
+}
+
+// Accessors.
+
+int S21MatrixBatch::count(void) const noexcept { return (count_); }
+
+int S21MatrixBatch::rows(void) const noexcept { return (rows_); }
+
+int S21MatrixBatch::cols(void) const noexcept { return (cols_); }
+
+S21MatrixBatch::Layout S21MatrixBatch::layout(void) const noexcept {
+  return (layout_);
+}
+
+double* S21MatrixBatch::data(void) noexcept { return (data_.data()); }
+
+const double* S21MatrixBatch::data(void) const noexcept {
+  return (data_.data());
+}
+
+S21MatrixBatch S21MatrixBatch::ToLayout(Layout layout) const {
+  if (layout == layout_) {
+    return (*this);
+  }
+
+  S21MatrixBatch result(count_, rows_, cols_, layout);
+  int size = rows_ * cols_;
+  const double* from = data();
+  double* to = result.data();
+  for (int b = 0; b < count_; ++b) {
+    std::size_t aos = static_cast<std::size_t>(b) * size;
+    std::size_t soa = static_cast<std::size_t>(b / kLanes) * size * kLanes +
+                      b % kLanes;
+    for (int e = 0; e < size; ++e) {
+      if (layout == Layout::kSoa) {
+        to[soa + e * kLanes] = from[aos + e];
+      } else {
+        to[aos + e] = from[soa + e * kLanes];
+      }
+    }
+  }
+
+  return (result);
+}
+
+S21Matrix S21MatrixBatch::Get(int index) const {
+  CheckIndex(index, 0, 0);
+  S21Matrix matrix(rows_, cols_);
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      matrix(i, j) = data_[Offset(index, i, j)];
+    }
+  }
+
+  return (matrix);
+}
+
+void S21MatrixBatch::Set(int index, const S21Matrix& matrix) {
+  CheckIndex(index, 0, 0);
+  if (matrix.rows() != rows_ || matrix.cols() != cols_) {
+    throw std::invalid_argument("Different matrix dimensions.");
+  }
+
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      data_[Offset(index, i, j)] = matrix(i, j);
+    }
+  }
+}
+
+// Operations.
+
+bool S21MatrixBatch::EqMatrix(const S21MatrixBatch& other) const {
+  bool equal =
+      count_ == other.count_ && rows_ == other.rows_ && cols_ == other.cols_;
+  if (equal) {
+    S21MatrixBatch lhs_converted(1, 1, 1);
+    S21MatrixBatch rhs_converted(1, 1, 1);
+    const S21MatrixBatch& lhs = Interleaved(lhs_converted);
+    const S21MatrixBatch& rhs = other.Interleaved(rhs_converted);
+    equal = s21::EqualKernel(lhs.data(), rhs.data(), lhs.data_.size(),
+                             S21Matrix::kEps);
+  }
+
+  return (equal);
+}
+
+void S21MatrixBatch::SumMatrix(const S21MatrixBatch& other) {
+  if (count_ != other.count_ || rows_ != other.rows_ ||
+      cols_ != other.cols_) {
+    throw std::invalid_argument("Different matrix dimensions.");
+  }
+
+  if (other.layout_ == layout_) {
+    s21::AddKernel(data(), other.data(), data_.size());
+  } else {
+    s21::AddKernel(data(), other.ToLayout(layout_).data(), data_.size());
+  }
+}
+
+void S21MatrixBatch::MulMatrix(const S21MatrixBatch& other) {
+  *this = Product(*this, other);
+}
+
+// Transposing moves whole elements, which in the interleaved layout are
+// runs of kLanes doubles.
+S21MatrixBatch S21MatrixBatch::Transpose(void) const {
+  S21MatrixBatch result(count_, cols_, rows_, layout_);
+  int matrices = layout_ == Layout::kSoa ? chunks() : count_;
+  int width = layout_ == Layout::kSoa ? kLanes : 1;
+  std::size_t size = static_cast<std::size_t>(rows_) * cols_ * width;
+  for (int b = 0; b < matrices; ++b) {
+    const double* from = data() + b * size;
+    double* to = result.data() + b * size;
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        memcpy(to + (j * rows_ + i) * width, from + (i * cols_ + j) * width,
+               width * sizeof(double));
+      }
+    }
+  }
+
+  return (result);
+}
+
+std::vector<double> S21MatrixBatch::Determinant(void) const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("The matrix is not square.");
+  }
+
+  S21MatrixBatch converted(1, 1, 1);
+  const S21MatrixBatch& batch = Interleaved(converted);
+  std::vector<double> det(static_cast<std::size_t>(chunks()) * kLanes);
+  std::vector<double> work(static_cast<std::size_t>(rows_) * cols_ * kLanes);
+  s21::BatchDeterminantKernel(batch.data(), det.data(), work.data(),
+                              chunks(), rows_);
+  det.resize(count_);
+
+  return (det);
+}
+
+S21MatrixBatch S21MatrixBatch::InverseMatrix(void) const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("The matrix is not square.");
+  }
+
+  S21MatrixBatch converted(1, 1, 1);
+  const S21MatrixBatch& batch = Interleaved(converted);
+  S21MatrixBatch inverse(count_, rows_, cols_);
+  std::vector<double> work(static_cast<std::size_t>(rows_) * cols_ * 2 *
+                           kLanes);
+  if (!s21::BatchInverseKernel(batch.data(), inverse.data(), work.data(),
+                               chunks(), rows_, count_)) {
+    throw std::invalid_argument(
+        "The matrix is singular and there is no inverse matrix.");
+  }
+  inverse.ClearPadding();
+  if (layout_ != Layout::kSoa) {
+    inverse = inverse.ToLayout(layout_);
+  }
+
+  return (inverse);
+}
+
+// Operators.
+
+S21MatrixBatch S21MatrixBatch::operator+(const S21MatrixBatch& other) const {
+  S21MatrixBatch tmp(*this);
+  tmp.SumMatrix(other);
+
+  return (tmp);
+}
+
+S21MatrixBatch S21MatrixBatch::operator*(const S21MatrixBatch& other) const {
+  return (Product(*this, other));
+}
+
+bool S21MatrixBatch::operator==(const S21MatrixBatch& other) const {
+  return (EqMatrix(other));
+}
+
+S21MatrixBatch& S21MatrixBatch::operator+=(const S21MatrixBatch& other) {
+  SumMatrix(other);
+  return (*this);
+}
+
+S21MatrixBatch& S21MatrixBatch::operator*=(const S21MatrixBatch& other) {
+  MulMatrix(other);
+  return (*this);
+}
+
+double& S21MatrixBatch::operator()(int index, int i, int j) {
+  CheckIndex(index, i, j);
+  return (data_[Offset(index, i, j)]);
+}
+
+const double& S21MatrixBatch::operator()(int index, int i, int j) const {
+  CheckIndex(index, i, j);
+  return (data_[Offset(index, i, j)]);
+}
+
+// Private methods.
+
+int S21MatrixBatch::chunks(void) const noexcept {
+  return ((count_ + kLanes - 1) / kLanes);
+}
+
+std::size_t S21MatrixBatch::Offset(int index, int i,
+                                   int j) const noexcept {
+  std::size_t size = static_cast<std::size_t>(rows_) * cols_;
+  std::size_t offset = 0;
+  if (layout_ == Layout::kAos) {
+    offset = index * size + i * cols_ + j;
+  } else {
+    offset = ((index / kLanes) * size + i * cols_ + j) * kLanes +
+             index % kLanes;
+  }
+
+  return (offset);
+}
+
+void S21MatrixBatch::CheckIndex(int index, int i, int j) const {
+  if (index < 0 || index >= count_) {
+    throw std::out_of_range("Index outside the range of matrices.");
+  }
+  if (i < 0 || i >= rows_) {
+    throw std::out_of_range("Index outside the range of rows.");
+  }
+  if (j < 0 || j >= cols_) {
+    throw std::out_of_range("Index outside the range of columns.");
+  }
+}
+
+S21MatrixBatch S21MatrixBatch::Product(const S21MatrixBatch& lhs,
+                                       const S21MatrixBatch& rhs) {
+  if (lhs.count_ != rhs.count_ || lhs.cols_ != rhs.rows_) {
+    throw std::invalid_argument("The matrices are incompatible.");
+  }
+
+  S21MatrixBatch lhs_converted(1, 1, 1);
+  S21MatrixBatch rhs_converted(1, 1, 1);
+  const S21MatrixBatch& a = lhs.Interleaved(lhs_converted);
+  const S21MatrixBatch& b = rhs.Interleaved(rhs_converted);
+  S21MatrixBatch product(lhs.count_, lhs.rows_, rhs.cols_);
+  s21::BatchProductKernel(a.data(), b.data(), product.data(), lhs.chunks(),
+                          lhs.rows_, lhs.cols_, rhs.cols_);
+  if (lhs.layout_ != Layout::kSoa) {
+    product = product.ToLayout(lhs.layout_);
+  }
+
+  return (product);
+}
+
+const S21MatrixBatch& S21MatrixBatch::Interleaved(
+    S21MatrixBatch& converted) const {
+  if (layout_ == Layout::kSoa) {
+    return (*this);
+  }
+  converted = ToLayout(Layout::kSoa);
+
+  return (converted);
+}
+
+// Keeps the matrices that pad the last interleaved chunk zero, so that
+// whole-buffer kernels may run over them.
+void S21MatrixBatch::ClearPadding(void) noexcept {
+  for (int b = count_; layout_ == Layout::kSoa && b < chunks() * kLanes;
+       ++b) {
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        data_[Offset(b, i, j)] = 0.0;
+      }
+    }
+  }
+}
@@ -0,0 +1,348 @@
+#include "s21_matrix_file.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+namespace {
+
+const char kFileMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+const std::uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+const std::uint64_t kFnvPrime = 1099511628211ull;
+// Attempts at a free temporary name before CreateTemporary gives up.
+const int kTemporaryAttempts = 100;
+
+[[noreturn]] void ThrowSystemError(const std::string& what,
+                                   const std::string& path) {
+  throw std::system_error(errno, std::generic_category(), what + " " + path);
+}
+
+}  // namespace
+
+FileHeader MakeFileHeader(int rows, int cols, int stride) noexcept {
+  FileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kFileMagic, sizeof(header.magic));
+  header.version = kFileVersion;
+  header.dtype = kFileDtypeFloat64;
+  header.layout = kFileLayoutRowMajor;
+  header.rows = rows;
+  header.cols = cols;
+  header.stride = stride;
+  header.data_offset = kFileDataOffset;
+
+  return (header);
+}
+
+// Checksum.
+
+Checksum::Checksum(void) noexcept : hash_(kFnvOffsetBasis) {}
+
+void Checksum::Update(const double* data, std::size_t n) noexcept {
+  std::uint64_t hash = hash_;
+  for (std::size_t i = 0; i < n; ++i) {
+    std::uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    hash = (hash ^ word) * kFnvPrime;
+  }
+  hash_ = hash;
+}
+
+// File.
+
+File File::OpenForReading(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    ThrowSystemError("Cannot open", path);
+  }
+
+  return (File(fd, path));
+}
+
+File File::Create(const std::string& path) {
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    ThrowSystemError("Cannot create", path);
+  }
+
+  return (File(fd, path));
+}
+
+File File::CreateTemporary(const std::string& path) {
+  static std::atomic<unsigned> counter{0};
+  std::string prefix = path + ".tmp" + std::to_string(getpid()) + ".";
+  for (int attempt = 0; attempt < kTemporaryAttempts; ++attempt) {
+    std::string name = prefix + std::to_string(counter.fetch_add(1));
+    int fd = open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd >= 0) {
+      return (File(fd, name));
+    } else if (errno != EEXIST) {
+      ThrowSystemError("Cannot create", name);
+    }
+  }
+  ThrowSystemError("Cannot create a temporary file for", path);
+}
+
+File::File(int fd, const std::string& path) noexcept : fd_(fd), path_(path) {}
+
+File::File(File&& other) noexcept
+    : fd_(other.fd_), path_(std::move(other.path_)) {
+  other.fd_ = -1;
+}
+
+File& File::operator=(File&& other) noexcept {
+  std::swap(fd_, other.fd_);
+  std::swap(path_, other.path_);
+  return (*this);
+}
+
+File::~File(void) {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+std::uint64_t File::Size(void) const {
+  struct stat st;
+  if (fstat(fd_, &st) != 0) {
+    ThrowSystemError("Cannot stat", path_);
+  }
+
+  return (static_cast<std::uint64_t>(st.st_size));
+}
+
+void File::Read(void* buffer, std::size_t bytes, std::uint64_t offset) const {
+  char* dst = static_cast<char*>(buffer);
+  while (bytes > 0) {
+    ssize_t done = pread(fd_, dst, bytes, static_cast<off_t>(offset));
+    if (done == 0) {
+      throw std::runtime_error("The matrix file is truncated: " + path_);
+    } else if (done < 0 && errno != EINTR) {
+      ThrowSystemError("Cannot read", path_);
+    } else if (done > 0) {
+      dst += done;
+      bytes -= static_cast<std::size_t>(done);
+      offset += static_cast<std::uint64_t>(done);
+    }
+  }
+}
+
+void File::Write(const void* buffer, std::size_t bytes, std::uint64_t offset) {
+  const char* src = static_cast<const char*>(buffer);
+  while (bytes > 0) {
+    ssize_t done = pwrite(fd_, src, bytes, static_cast<off_t>(offset));
+    if (done == 0) {
+      throw std::system_error(EIO, std::generic_category(),
+                              "Cannot write " + path_);
+    } else if (done < 0 && errno != EINTR) {
+      ThrowSystemError("Cannot write", path_);
+    } else if (done > 0) {
+      src += done;
+      bytes -= static_cast<std::size_t>(done);
+      offset += static_cast<std::uint64_t>(done);
+    }
+  }
+}
+
+void File::Resize(std::uint64_t size) {
+  if (ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+    ThrowSystemError("Cannot resize", path_);
+  }
+}
+
+void File::Replace(const std::string& path) {
+  if (fsync(fd_) != 0) {
+    ThrowSystemError("Cannot sync", path_);
+  }
+  if (rename(path_.c_str(), path.c_str()) != 0) {
+    ThrowSystemError("Cannot rename " + path_ + " to", path);
+  }
+  path_ = path;
+}
+
+void File::Unlink(void) noexcept { unlink(path_.c_str()); }
+
+FileHeader File::ReadHeader(void) const {
+  std::uint64_t size = Size();
+  FileHeader header;
+  if (size < sizeof(header)) {
+    throw std::runtime_error("The file is not a matrix file: " + path_);
+  }
+  Read(&header, sizeof(header), 0);
+
+  if (memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0) {
+    throw std::runtime_error("The file is not a matrix file: " + path_);
+  }
+  if (header.version != kFileVersion) {
+    throw std::runtime_error("Unsupported matrix file version: " + path_);
+  }
+  if (header.dtype != kFileDtypeFloat64 ||
+      header.layout != kFileLayoutRowMajor) {
+    throw std::runtime_error("Unsupported matrix element type: " + path_);
+  }
+
+  const std::int64_t kMaxExtent = std::numeric_limits<int>::max();
+  if (header.rows < 1 || header.cols < 1 || header.stride < header.cols ||
+      header.rows > kMaxExtent || header.stride > kMaxExtent ||
+      header.data_offset < sizeof(header) ||
+      header.data_offset % sizeof(double) != 0) {
+    throw std::runtime_error("The matrix file header is corrupted: " + path_);
+  }
+  std::uint64_t data_bytes = static_cast<std::uint64_t>(header.rows) *
+                             static_cast<std::uint64_t>(header.stride) *
+                             sizeof(double);
+  if (size < header.data_offset || size - header.data_offset < data_bytes) {
+    throw std::runtime_error("The matrix file is truncated: " + path_);
+  }
+
+  return (header);
+}
+
+// Rows that are adjacent both in the file and in the buffer are transferred
+// with a single call.
+void File::ReadBlock(const FileHeader& header, int row, int col, int rows,
+                     int cols, double* buffer, std::ptrdiff_t ld) const {
+  std::uint64_t offset =
+      header.data_offset +
+      (static_cast<std::uint64_t>(row) * header.stride + col) * sizeof(double);
+  if (cols == header.stride && ld == cols) {
+    Read(buffer, static_cast<std::size_t>(rows) * cols * sizeof(double),
+         offset);
+  } else {
+    for (int i = 0; i < rows; ++i) {
+      Read(buffer + i * ld, cols * sizeof(double), offset);
+      offset += header.stride * sizeof(double);
+    }
+  }
+}
+
+void File::WriteBlock(const FileHeader& header, int row, int col, int rows,
+                      int cols, const double* buffer, std::ptrdiff_t ld) {
+  std::uint64_t offset =
+      header.data_offset +
+      (static_cast<std::uint64_t>(row) * header.stride + col) * sizeof(double);
+  if (cols == header.stride && ld == cols) {
+    Write(buffer, static_cast<std::size_t>(rows) * cols * sizeof(double),
+          offset);
+  } else {
+    for (int i = 0; i < rows; ++i) {
+      Write(buffer + i * ld, cols * sizeof(double), offset);
+      offset += header.stride * sizeof(double);
+    }
+  }
+}
+
+std::uint64_t File::ComputeChecksum(const FileHeader& header) const {
+  std::uint64_t total = static_cast<std::uint64_t>(header.rows) *
+                        static_cast<std::uint64_t>(header.stride);
+  std::vector<double> chunk(kFileChunkBytes / sizeof(double));
+  Checksum checksum;
+  for (std::uint64_t done = 0; done < total;) {
+    std::size_t count = static_cast<std::size_t>(
+        std::min<std::uint64_t>(chunk.size(), total - done));
+    Read(chunk.data(), count * sizeof(double),
+         header.data_offset + done * sizeof(double));
+    checksum.Update(chunk.data(), count);
+    done += count;
+  }
+
+  return (checksum.value());
+}
+
+}  // namespace s21
+
+// Persistence of S21Matrix.
+
+template <>
+void S21Matrix::Save(const std::string& path) const {
+  if (rows_ < 1 || cols_ < 1) {
+    throw std::invalid_argument("The matrix is empty.");
+  }
+  int stride = PaddedStride(cols_);
+  // Truncating path in place would pull the pages from under a matrix
+  // loaded from it, possibly this one, so the rows go to a new file that
+  // is renamed over path once complete.
+  s21::File file = s21::File::CreateTemporary(path);
+  s21::FileHeader header = s21::MakeFileHeader(rows_, cols_, stride);
+  s21::Checksum checksum;
+
+  try {
+    int chunk_rows = std::max<int>(
+        1, static_cast<int>(s21::kFileChunkBytes / sizeof(double) / stride));
+    std::vector<double> chunk(static_cast<std::size_t>(chunk_rows) * stride,
+                              0.0);
+    std::uint64_t offset = header.data_offset;
+    for (int first = 0; first < rows_; first += chunk_rows) {
+      int count = std::min(chunk_rows, rows_ - first);
+      for (int i = 0; i < count; ++i) {
+        memcpy(chunk.data() + static_cast<std::size_t>(i) * stride,
+               Row(first + i), cols_ * sizeof(double));
+      }
+      std::size_t elements = static_cast<std::size_t>(count) * stride;
+      checksum.Update(chunk.data(), elements);
+      file.Write(chunk.data(), elements * sizeof(double), offset);
+      offset += elements * sizeof(double);
+    }
+
+    header.checksum = checksum.value();
+    file.Write(&header, sizeof(header), 0);
+    file.Replace(path);
+  } catch (...) {
+    file.Unlink();
+    throw;
+  }
+}
+
+template <>
+S21Matrix S21Matrix::Load(const std::string& path, bool verify) {
+  s21::File file = s21::File::OpenForReading(path);
+  s21::FileHeader header = file.ReadHeader();
+  std::size_t length = static_cast<std::size_t>(file.Size());
+
+  // A private writable mapping lets the matrix be modified like any other
+  // without touching the file; MAP_NORESERVE keeps large mappings from being
+  // refused under strict overcommit accounting.
+  void* base = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_NORESERVE, file.fd(), 0);
+  if (base == MAP_FAILED) {
+    s21::ThrowSystemError("Cannot map", path);
+  }
+
+  double* data = reinterpret_cast<double*>(static_cast<char*>(base) +
+                                           header.data_offset);
+  int rows = static_cast<int>(header.rows);
+  int cols = static_cast<int>(header.cols);
+  int stride = static_cast<int>(header.stride);
+  try {
+    if (verify) {
+      s21::Checksum checksum;
+      checksum.Update(data, static_cast<std::size_t>(rows) * stride);
+      if (checksum.value() != header.checksum) {
+        throw std::runtime_error("The matrix file checksum does not match: " +
+                                 path);
+      }
+    }
+
+    return (Adopt(data, rows, cols, stride, [base, length](double*) {
+      munmap(base, length);
+    }));
+  } catch (...) {
+    munmap(base, length);
+    throw;
+  }
+}
@@ -0,0 +1,94 @@
+#ifndef S21_MATRIX_FILE_H_
+#define S21_MATRIX_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace s21 {
+
+// On-disk matrix format. The file starts with a 64-byte header followed, at
+// data_offset, by rows * stride doubles in row-major order and native byte
+// order. The checksum is FNV-1a over the data taken as 64-bit words, padding
+// included.
+struct FileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t dtype;
+  std::uint32_t layout;
+  std::uint32_t reserved;
+  std::int64_t rows;
+  std::int64_t cols;
+  std::int64_t stride;
+  std::uint64_t checksum;
+  std::uint64_t data_offset;
+};
+
+static_assert(sizeof(FileHeader) == 64, "The file header must be 64 bytes.");
+
+constexpr std::uint32_t kFileVersion = 1;
+constexpr std::uint32_t kFileDtypeFloat64 = 1;
+constexpr std::uint32_t kFileLayoutRowMajor = 0;
+constexpr std::uint64_t kFileDataOffset = sizeof(FileHeader);
+// Amount of data Save gathers before each write.
+constexpr std::size_t kFileChunkBytes = 1 << 20;
+
+FileHeader MakeFileHeader(int rows, int cols, int stride) noexcept;
+
+class Checksum {
+ public:
+  Checksum(void) noexcept;
+  void Update(const double* data, std::size_t n) noexcept;
+  std::uint64_t value(void) const noexcept { return (hash_); }
+
+ private:
+  std::uint64_t hash_;
+};
+
+// Owns a file descriptor. Every failure is reported as std::system_error for
+// the operating system and std::runtime_error for malformed contents.
+class File {
+ public:
+  static File OpenForReading(const std::string& path);
+  static File Create(const std::string& path);
+  // Creates a new file with a unique name in the directory of path, to be
+  // renamed over path by Replace once it is complete.
+  static File CreateTemporary(const std::string& path);
+
+  File(File&& other) noexcept;
+  File& operator=(File&& other) noexcept;
+  File(const File&) = delete;
+  File& operator=(const File&) = delete;
+  ~File(void);
+
+  int fd(void) const noexcept { return (fd_); }
+  std::uint64_t Size(void) const;
+  void Read(void* buffer, std::size_t bytes, std::uint64_t offset) const;
+  void Write(const void* buffer, std::size_t bytes, std::uint64_t offset);
+  void Resize(std::uint64_t size);
+  // Flushes the file to disk and renames it to path, replacing any file
+  // there. A process that mapped the old file keeps its contents.
+  void Replace(const std::string& path);
+  // Removes the file from its directory; the descriptor stays open.
+  void Unlink(void) noexcept;
+  // Reads and validates the header against the size of the file.
+  FileHeader ReadHeader(void) const;
+  // Transfer the rows x cols block at (row, col) of the matrix described by
+  // header to or from buffer, whose rows are ld elements apart.
+  void ReadBlock(const FileHeader& header, int row, int col, int rows,
+                 int cols, double* buffer, std::ptrdiff_t ld) const;
+  void WriteBlock(const FileHeader& header, int row, int col, int rows,
+                  int cols, const double* buffer, std::ptrdiff_t ld);
+  // Checksum of the data of the matrix described by header.
+  std::uint64_t ComputeChecksum(const FileHeader& header) const;
+
+ private:
+  int fd_;
+  std::string path_;
+
+  File(int fd, const std::string& path) noexcept;
+};
+
+}  // namespace s21
+
+#endif  // S21_MATRIX_FILE_H_
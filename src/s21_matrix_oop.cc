@@ -3,21 +3,94 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <limits>
+#include <new>
 #include <stdexcept>
 #include <utility>
+#include <vector>
+
+#include "s21_factorization.h"
+#include "s21_gemm.h"
+#include "s21_instrument.h"
+#include "s21_kernels.h"
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_view.h"
+#include "s21_strassen.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Strassen products and the factorizations of s21_factorization.h are
+// implemented for double elements only.
+template <typename T>
+constexpr bool kIsDouble = std::is_same<T, double>::value;
+
+// The type of |x| for an element x: the element type itself, or the type of
+// the parts of a complex number.
+template <typename T>
+struct RealOf {
+  typedef T type;
+};
+
+template <typename T>
+struct RealOf<std::complex<T>> {
+  typedef T type;
+};
+
+// Besides kEps, EqMatrix accepts differences up to this fraction of the
+// smaller magnitude: 1024 units in the last place of the real type. Double
+// keeps the purely absolute tolerance of the original S21Matrix.
+template <typename T>
+const double kRelativeEps =
+    kIsDouble<T> ? 0.0
+                 : 1024.0 * static_cast<double>(std::numeric_limits<
+                                typename RealOf<T>::type>::epsilon());
+
+template <typename T>
+typename RealOf<T>::type MaxAbs(const S21BasicMatrix<T>& matrix) noexcept {
+  typename RealOf<T>::type max_abs = 0;
+  for (const T* row : matrix.Rows()) {
+    for (int j = 0; j < matrix.cols(); ++j) {
+      max_abs = std::max(max_abs, std::abs(row[j]));
+    }
+  }
 
-const int S21Matrix::kDefaultRows = 1;
-const int S21Matrix::kDefaultCols = 1;
-const double S21Matrix::kEps = 1.0e-6;
+  return (max_abs);
+}
+
+}  // namespace
+
+template <typename T>
+const int S21BasicMatrix<T>::kDefaultRows = 1;
+template <typename T>
+const int S21BasicMatrix<T>::kDefaultCols = 1;
+template <typename T>
+const double S21BasicMatrix<T>::kEps = std::max(
+    1.0e-6, 1024.0 * static_cast<double>(std::numeric_limits<
+                         typename RealOf<T>::type>::epsilon()));
+template <typename T>
+const int S21BasicMatrix<T>::kStrideAlignment = kAlignment / sizeof(T);
+template <typename T>
+const int S21BasicMatrix<T>::kExactDeterminantMaxSize = 8;
+template <typename T>
+const int S21BasicMatrix<T>::kCofactorMaxSize = 6;
+template <typename T>
+const int S21BasicMatrix<T>::kParallelMinSize = 128;
+template <typename T>
+const int S21BasicMatrix<T>::kParallelGrain = 16;
 
 // Constructors and Destructor.
 
-S21Matrix::S21Matrix(void) : rows_(kDefaultRows), cols_(kDefaultCols) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(void)
+    : rows_(kDefaultRows), cols_(kDefaultCols) {
   AllocateMatrix(kDefaultRows, kDefaultCols);
   ResetMatrix();
 }
 
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : rows_(rows), cols_(cols) {
   if (rows < 1) {
     throw std::invalid_argument("The number of rows is less than 1.");
   }
@@ -29,150 +102,272 @@ S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
   ResetMatrix();
 }
 
-S21Matrix::S21Matrix(const S21Matrix& other)
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix& other)
     : rows_(other.rows_), cols_(other.cols_) {
   AllocateMatrix(rows_, cols_);
   CopyMatrix(other);
 }
 
-S21Matrix::S21Matrix(S21Matrix&& other) noexcept
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix&& other) noexcept
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      storage_(other.storage_),
+      data_(other.data_),
+      deleter_(other.deleter_),
+      allocator_(other.allocator_) {
+  if (other.IsInline()) {
+    memcpy(inline_, other.inline_, capacity() * sizeof(*data_));
+    data_ = inline_;
+  }
   other.rows_ = 0;
   other.cols_ = 0;
-  other.matrix_ = nullptr;
+  other.stride_ = 0;
+  other.storage_ = Storage::kHeap;
+  other.data_ = nullptr;
+  other.deleter_ = nullptr;
+  other.allocator_ = nullptr;
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(T* data, int rows, int cols, int stride,
+                                  Storage storage, Deleter* deleter) noexcept
+    : rows_(rows),
+      cols_(cols),
+      stride_(stride),
+      storage_(storage),
+      data_(data),
+      deleter_(deleter),
+      allocator_(nullptr) {}
+
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix(void) {
+  if (data_ == nullptr) {
+    return;
+  }
+  if (storage_ == Storage::kHeap) {
+    allocator_->Deallocate(data_, capacity() * sizeof(*data_));
+  } else if (storage_ == Storage::kAdopted) {
+    (*deleter_)(data_);
+    delete deleter_;
+  }
 }
 
-S21Matrix::~S21Matrix(void) {
-  if (matrix_ != nullptr) {
-    delete[] matrix_[0];
-    delete[] matrix_;
+// External storage.
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Borrow(T* data, int rows, int cols,
+                                            int stride) {
+  CheckExternal(data, rows, cols, stride);
+
+  return (
+      S21BasicMatrix(data, rows, cols, stride, Storage::kBorrowed, nullptr));
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Adopt(T* data, int rows, int cols,
+                                           int stride, Deleter deleter) {
+  CheckExternal(data, rows, cols, stride);
+  if (!deleter) {
+    throw std::invalid_argument("The deleter is empty.");
   }
+
+  return (S21BasicMatrix(data, rows, cols, stride, Storage::kAdopted,
+                         new Deleter(std::move(deleter))));
 }
 
 // Accessors and Mutators.
 
-int S21Matrix::rows(void) const noexcept { return (rows_); }
+template <typename T>
+int S21BasicMatrix<T>::rows(void) const noexcept { return (rows_); }
 
-int S21Matrix::cols(void) const noexcept { return (cols_); }
+template <typename T>
+int S21BasicMatrix<T>::cols(void) const noexcept { return (cols_); }
 
-void S21Matrix::set_rows(int rows) {
+template <typename T>
+typename S21BasicMatrix<T>::Storage S21BasicMatrix<T>::storage(
+    void) const noexcept {
+  return (storage_);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::set_rows(int rows) {
   if (rows < 1) {
     throw std::invalid_argument("The number of rows is less than one.");
   }
 
   if (rows != rows_) {
-    S21Matrix tmp(rows, cols_);
+    S21BasicMatrix tmp(rows, cols_);
     tmp.CopyMatrix(*this);
     SwapMatrix(tmp);
   }
 }
 
-void S21Matrix::set_cols(int cols) {
+template <typename T>
+void S21BasicMatrix<T>::set_cols(int cols) {
   if (cols < 1) {
     throw std::invalid_argument("The number of rows is less than one.");
   }
 
   if (cols != cols_) {
-    S21Matrix tmp(rows_, cols);
+    S21BasicMatrix tmp(rows_, cols);
     tmp.CopyMatrix(*this);
     SwapMatrix(tmp);
   }
 }
 
+template <typename T>
+int S21BasicMatrix<T>::thread_count(void) noexcept {
+  return (s21::ThreadPool::Instance().size());
+}
+
+template <typename T>
+void S21BasicMatrix<T>::set_thread_count(int count) {
+  if (count < 1) {
+    throw std::invalid_argument("The number of threads is less than one.");
+  }
+
+  s21::ThreadPool::Instance().Resize(count);
+}
+
+template <>
+S21MatrixView S21BasicMatrix<double>::View(void) noexcept {
+  return (S21MatrixView(data_, rows_, cols_, stride_));
+}
+
+template <>
+S21ConstMatrixView S21BasicMatrix<double>::View(void) const noexcept {
+  return (S21ConstMatrixView(data_, rows_, cols_, stride_));
+}
+
 // Member Functions.
 
-bool S21Matrix::EqMatrix(const S21Matrix& other) const noexcept {
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(
+    const S21BasicMatrix& other) const noexcept {
+  s21::OperationScope scope(S21MatrixStats::Operation::kEqMatrix,
+                            size() + other.size());
   bool result = true;
 
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     result = false;
+  } else if (IsContiguous() && other.IsContiguous()) {
+    result = s21::EqualKernel(data_, other.data_, size(), kEps,
+                               kRelativeEps<T>);
   } else {
     for (int i = 0; result == true && i < rows_; ++i) {
-      for (int j = 0; result == true && j < cols_; ++j) {
-        if (fabs(matrix_[i][j] - other.matrix_[i][j]) > kEps) {
-          result = false;
-        }
-      }
+      result = s21::EqualKernel(Row(i), other.Row(i), cols_, kEps,
+                                kRelativeEps<T>);
     }
   }
 
   return (result);
 }
 
-void S21Matrix::SumMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix& other) {
+  s21::OperationScope scope(S21MatrixStats::Operation::kSumMatrix,
+                            size() + other.size());
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument("Different matrix dimensions.");
   }
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] += other.matrix_[i][j];
+  if (IsContiguous() && other.IsContiguous()) {
+    s21::AddKernel(data_, other.data_, size());
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      s21::AddKernel(Row(i), other.Row(i), cols_);
     }
   }
 }
 
-void S21Matrix::SubMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix& other) {
+  s21::OperationScope scope(S21MatrixStats::Operation::kSubMatrix,
+                            size() + other.size());
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument("Different matrix dimensions.");
   }
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] -= other.matrix_[i][j];
+  if (IsContiguous() && other.IsContiguous()) {
+    s21::SubKernel(data_, other.data_, size());
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      s21::SubKernel(Row(i), other.Row(i), cols_);
     }
   }
 }
 
-void S21Matrix::MulMatrix(double num) noexcept {
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] *= num;
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(T num) noexcept {
+  s21::OperationScope scope(S21MatrixStats::Operation::kMulNumber, size());
+  if (IsContiguous()) {
+    s21::ScaleKernel(data_, num, size());
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      s21::ScaleKernel(Row(i), num, cols_);
     }
   }
 }
 
-void S21Matrix::MulMatrix(const S21Matrix& other) {
-  S21Matrix tmp(rows_, other.cols_);
-
-  if (cols_ != other.rows_) {
-    throw std::invalid_argument("The matrices are incompatible.");
-  }
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other) {
+  S21BasicMatrix tmp = Product(*this, other);
+  TakeMatrix(tmp);
+}
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < other.cols_; ++j) {
-      for (int k = 0; k < cols_; ++k) {
-        tmp.matrix_[i][j] += matrix_[i][k] * other.matrix_[k][j];
-      }
-    }
-  }
-  SwapMatrix(tmp);
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other,
+                                  Multiplication multiplication) {
+  S21BasicMatrix tmp = Product(*this, other, multiplication);
+  TakeMatrix(tmp);
 }
 
-S21Matrix S21Matrix::Transpose(void) const {
-  S21Matrix tmp(cols_, rows_);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose(void) const {
+  s21::OperationScope scope(S21MatrixStats::Operation::kTranspose, size());
+  S21BasicMatrix tmp(cols_, rows_);
 
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
-      tmp.matrix_[j][i] = matrix_[i][j];
+      tmp.Row(j)[i] = Row(i)[j];
     }
   }
 
   return (tmp);
 }
 
-S21Matrix S21Matrix::CalcComplements(void) const {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements(void) const {
+  s21::OperationScope scope(S21MatrixStats::Operation::kCalcComplements,
+                            size());
   if (rows_ != cols_) {
     throw std::invalid_argument("The matrix is not square.");
   }
 
-  S21Matrix complements(rows_, cols_);
+  // Small minors go through the cofactor expansion so that integer-valued
+  // matrices keep exact integer complements. Larger invertible matrices use
+  // adj(A) = det(A) * A^-1 from a single factorization, which is O(n^3)
+  // instead of one O(n^3) determinant per minor; only singular ones, whose
+  // adjugate may still be nonzero, fall back to the minors.
+  bool exact = rows_ <= kCofactorMaxSize;
+  S21BasicMatrix complements(rows_, cols_);
+  S21BasicMatrix inverse;
+  T det = T(0);
   if (rows_ == 1) {
-    complements.matrix_[0][0] = 1.0;
+    complements.Row(0)[0] = T(1);
+  } else if (!exact && Invert(inverse, det)) {
+    complements = inverse.Transpose();
+    complements.MulMatrix(det);
   } else {
     for (int i = 0; i < rows_; ++i) {
       for (int j = 0; j < cols_; ++j) {
-        double sign = (i + j) % 2 ? -1.0 : 1.0;
-        complements(i, j) = sign * Minor(i, j).Determinant();
+        T sign = (i + j) % 2 ? T(-1) : T(1);
+        S21BasicMatrix minor = Minor(i, j);
+        complements(i, j) =
+            sign * (exact ? minor.ExactDeterminant() : minor.Determinant());
       }
     }
   }
@@ -180,90 +375,83 @@ S21Matrix S21Matrix::CalcComplements(void) const {
   return (complements);
 }
 
-double S21Matrix::Determinant(void) const {
+template <typename T>
+T S21BasicMatrix<T>::Determinant(void) const {
+  s21::OperationScope scope(S21MatrixStats::Operation::kDeterminant, size());
   if (rows_ != cols_) {
     throw std::invalid_argument("The matrix is not square.");
   }
 
-  double det = 0.0;
+  T det = T(0);
+  if (rows_ <= 3) {
+    det = ExactDeterminant();
+  } else if (!kIsDouble<T> || rows_ < S21LU::kBlockedMinSize) {
+    det = LuDeterminant();
+  } else if constexpr (kIsDouble<T>) {
+    det = S21LU(*this).Determinant();
+  }
+
+  return (det);
+}
+
+template <typename T>
+T S21BasicMatrix<T>::ExactDeterminant(void) const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("The matrix is not square.");
+  }
+  if (rows_ > kExactDeterminantMaxSize) {
+    throw std::invalid_argument(
+        "The matrix is too large for the cofactor expansion.");
+  }
+
+  T det = T(0);
   if (rows_ == 1) {
-    det = matrix_[0][0];
+    det = Row(0)[0];
   } else if (rows_ == 2) {
-    det = matrix_[0][0] * matrix_[1][1] - matrix_[0][1] * matrix_[1][0];
+    det = Row(0)[0] * Row(1)[1] - Row(0)[1] * Row(1)[0];
   } else if (rows_ == 3) {
-    det = matrix_[0][0] * matrix_[1][1] * matrix_[2][2] -
-          matrix_[0][0] * matrix_[1][2] * matrix_[2][1] -
-          matrix_[0][1] * matrix_[1][0] * matrix_[2][2] +
-          matrix_[0][1] * matrix_[1][2] * matrix_[2][0] +
-          matrix_[0][2] * matrix_[1][0] * matrix_[2][1] -
-          matrix_[0][2] * matrix_[1][1] * matrix_[2][0];
+    det = Row(0)[0] * Row(1)[1] * Row(2)[2] -
+          Row(0)[0] * Row(1)[2] * Row(2)[1] -
+          Row(0)[1] * Row(1)[0] * Row(2)[2] +
+          Row(0)[1] * Row(1)[2] * Row(2)[0] +
+          Row(0)[2] * Row(1)[0] * Row(2)[1] -
+          Row(0)[2] * Row(1)[1] * Row(2)[0];
   } else {
     for (int j = 0; j < cols_; ++j) {
-      double sign = j % 2 ? -1.0 : 1.0;
-      det += sign * matrix_[0][j] * Minor(0, j).Determinant();
+      T sign = j % 2 ? T(-1) : T(1);
+      det += sign * Row(0)[j] * Minor(0, j).ExactDeterminant();
     }
   }
 
   return (det);
 }
 
-S21Matrix S21Matrix::InverseMatrix(void) const {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix(void) const {
+  s21::OperationScope scope(S21MatrixStats::Operation::kInverseMatrix,
+                            size());
   if (rows_ != cols_) {
     throw std::invalid_argument("The matrix is not square.");
   }
 
-  double det = Determinant();
-  if (fabs(det) < kEps) {
+  S21BasicMatrix inverse;
+  T det = T(0);
+  if (!Invert(inverse, det)) {
     throw std::invalid_argument(
-        "The determinant is zero and there is no inverse matrix.");
+        "The matrix is singular and there is no inverse matrix.");
   }
-  det = 1.0 / det;
 
-  return (CalcComplements().Transpose() * det);
+  return (inverse);
 }
 
 // Operator Overloading
 
-S21Matrix S21Matrix::operator+(const S21Matrix& other) const {
-  S21Matrix tmp(*this);
-
-  tmp.SumMatrix(other);
-
-  return (tmp);
-}
-
-S21Matrix S21Matrix::operator-(const S21Matrix& other) const {
-  S21Matrix tmp(*this);
-
-  tmp.SubMatrix(other);
-
-  return (tmp);
-}
-
-S21Matrix S21Matrix::operator*(const S21Matrix& other) const {
-  S21Matrix tmp(*this);
-
-  tmp.MulMatrix(other);
-
-  return (tmp);
-}
-
-S21Matrix S21Matrix::operator*(double num) const {
-  S21Matrix tmp(*this);
-
-  tmp.MulMatrix(num);
-
-  return (tmp);
-}
-
-bool S21Matrix::operator==(const S21Matrix& other) const noexcept {
-  return (EqMatrix(other));
-}
-
-S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(
+    const S21BasicMatrix& other) {
   if (this != &other) {
     if (rows_ != other.rows_ || cols_ != other.cols_) {
-      S21Matrix(other).SwapMatrix(*this);
+      S21BasicMatrix(other).SwapMatrix(*this);
     } else {
       CopyMatrix(other);
     }
@@ -272,91 +460,219 @@ S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
   return (*this);
 }
 
-S21Matrix& S21Matrix::operator=(S21Matrix&& other) noexcept {
-  SwapMatrix(other);
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(
+    S21BasicMatrix&& other) noexcept {
+  TakeMatrix(other);
   return (*this);
 }
 
-S21Matrix& S21Matrix::operator+=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(
+    const S21BasicMatrix& other) {
   SumMatrix(other);
   return (*this);
 }
 
-S21Matrix& S21Matrix::operator-=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(
+    const S21BasicMatrix& other) {
   SubMatrix(other);
   return (*this);
 }
 
-S21Matrix& S21Matrix::operator*=(double num) noexcept {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(T num) noexcept {
   MulMatrix(num);
   return (*this);
 }
 
-S21Matrix& S21Matrix::operator*=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(
+    const S21BasicMatrix& other) {
   MulMatrix(other);
   return (*this);
 }
 
-const double& S21Matrix::operator()(int i, int j) const {
-  if (i < 0 || i >= rows_) {
-    throw std::out_of_range("Index outside the range of rows.");
+template <typename T>
+const T& S21BasicMatrix<T>::operator()(int i, int j) const {
+  CheckRow(i);
+  CheckCol(j);
+
+  return (Row(i)[j]);
+}
+
+template <typename T>
+T& S21BasicMatrix<T>::operator()(int i, int j) {
+  CheckRow(i);
+  CheckCol(j);
+
+  return (Row(i)[j]);
+}
+
+// Auxiliary private member functions.
+
+template <typename T>
+void S21BasicMatrix<T>::AllocateMatrix(int rows, int cols) {
+  stride_ = PaddedStride(cols);
+  deleter_ = nullptr;
+  allocator_ = nullptr;
+  if (static_cast<std::size_t>(rows) * stride_ <= kInlineCapacity) {
+    storage_ = Storage::kInline;
+    data_ = inline_;
+  } else {
+    std::size_t elements = static_cast<std::size_t>(rows) * stride_;
+    s21::OperationScope scope(S21MatrixStats::Operation::kAllocateMatrix,
+                              elements);
+    storage_ = Storage::kHeap;
+    allocator_ = &S21MatrixAllocator::Current();
+    data_ = static_cast<T*>(allocator_->Allocate(elements * sizeof(*data_)));
+    s21::CountAllocation(elements * sizeof(*data_));
   }
-  if (j < 0 || j >= cols_) {
-    throw std::out_of_range("Index outside the range of columns.");
+}
+
+// Rows are padded to a whole number of cache lines once they are at least
+// one cache line wide, so that every row starts on an aligned boundary.
+// Narrower rows are packed tightly: padding them would more than double the
+// footprint of the small matrices that dominate typical use.
+template <typename T>
+int S21BasicMatrix<T>::PaddedStride(int cols) noexcept {
+  int stride = cols;
+  if (cols >= kStrideAlignment) {
+    stride = (cols + kStrideAlignment - 1) / kStrideAlignment *
+             kStrideAlignment;
   }
 
-  return (matrix_[i][j]);
+  return (stride);
 }
 
-double& S21Matrix::operator()(int i, int j) {
+template <typename T>
+void S21BasicMatrix<T>::CheckRow(int i) const {
   if (i < 0 || i >= rows_) {
     throw std::out_of_range("Index outside the range of rows.");
   }
+}
+
+template <typename T>
+void S21BasicMatrix<T>::CheckCol(int j) const {
   if (j < 0 || j >= cols_) {
     throw std::out_of_range("Index outside the range of columns.");
   }
-
-  return (matrix_[i][j]);
 }
 
-// Auxiliary private member functions.
-
-void S21Matrix::AllocateMatrix(int rows, int cols) {
-  matrix_ = new double*[rows];
-  matrix_[0] = new double[rows * cols];
-  for (int i = 1; i < rows; ++i) {
-    matrix_[i] = matrix_[0] + i * cols_;
+template <typename T>
+void S21BasicMatrix<T>::CheckExternal(const T* data, int rows, int cols,
+                                      int stride) {
+  if (data == nullptr) {
+    throw std::invalid_argument("The buffer is null.");
+  }
+  if (rows < 1) {
+    throw std::invalid_argument("The number of rows is less than 1.");
+  }
+  if (cols < 1) {
+    throw std::invalid_argument("The number of columns is less than 1.");
+  }
+  if (stride < cols) {
+    throw std::invalid_argument("The row stride is less than the columns.");
   }
 }
 
-void S21Matrix::ResetMatrix(void) noexcept {
-  memset(matrix_[0], 0, rows_ * cols_ * sizeof(matrix_[0][0]));
+template <typename T>
+void S21BasicMatrix<T>::ResetMatrix(void) noexcept {
+  std::fill_n(data_, capacity(), T(0));
 }
 
-void S21Matrix::CopyMatrix(const S21Matrix& other) noexcept {
+template <typename T>
+void S21BasicMatrix<T>::CopyMatrix(const S21BasicMatrix& other) noexcept {
+  s21::OperationScope scope(S21MatrixStats::Operation::kCopyMatrix,
+                            other.size());
   int min_rows = std::min(rows_, other.rows_);
   int min_cols = std::min(cols_, other.cols_);
 
-  if (cols_ == other.cols_) {
-    memcpy(matrix_[0], other.matrix_[0],
-           min_rows * min_cols * sizeof(matrix_[0][0]));
+  if (IsContiguous() && other.IsContiguous() && cols_ == other.cols_) {
+    memcpy(data_, other.data_, min_rows * min_cols * sizeof(*data_));
   } else {
     for (int i = 0; i < min_rows; ++i) {
-      for (int j = 0; j < min_cols; ++j) {
-        matrix_[i][j] = other.matrix_[i][j];
-      }
+      memcpy(Row(i), other.Row(i), min_cols * sizeof(*data_));
     }
   }
 }
 
-void S21Matrix::SwapMatrix(S21Matrix& other) noexcept {
+// Borrowed storage keeps receiving the results of the same shape, so the
+// caller's buffer stays the matrix; anything else is swapped in.
+template <typename T>
+void S21BasicMatrix<T>::TakeMatrix(S21BasicMatrix& other) noexcept {
+  if (this == &other) {
+    return;
+  } else if (storage_ == Storage::kBorrowed && rows_ == other.rows_ &&
+             cols_ == other.cols_) {
+    CopyMatrix(other);
+  } else {
+    SwapMatrix(other);
+  }
+}
+
+// Heap buffers are exchanged by pointer; inline buffers have to be copied
+// because they live inside the objects.
+template <typename T>
+void S21BasicMatrix<T>::SwapMatrix(S21BasicMatrix& other) noexcept {
+  std::size_t bytes = capacity() * sizeof(*data_);
+  std::size_t other_bytes = other.capacity() * sizeof(*data_);
+
+  if (this == &other) {
+    return;
+  } else if (IsInline() && other.IsInline()) {
+    T tmp[kInlineCapacity];
+    memcpy(tmp, inline_, bytes);
+    memcpy(inline_, other.inline_, other_bytes);
+    memcpy(other.inline_, tmp, bytes);
+  } else if (IsInline()) {
+    memcpy(other.inline_, inline_, bytes);
+    data_ = other.data_;
+    other.data_ = other.inline_;
+  } else if (other.IsInline()) {
+    memcpy(inline_, other.inline_, other_bytes);
+    other.data_ = data_;
+    data_ = inline_;
+  } else {
+    std::swap(data_, other.data_);
+  }
   std::swap(rows_, other.rows_);
   std::swap(cols_, other.cols_);
-  std::swap(matrix_, other.matrix_);
+  std::swap(stride_, other.stride_);
+  std::swap(storage_, other.storage_);
+  std::swap(deleter_, other.deleter_);
+  std::swap(allocator_, other.allocator_);
+}
+
+template <typename T>
+T* S21BasicMatrix<T>::Row(int i) noexcept {
+  return (data_ + static_cast<std::ptrdiff_t>(i) * stride_);
+}
+
+template <typename T>
+const T* S21BasicMatrix<T>::Row(int i) const noexcept {
+  return (data_ + static_cast<std::ptrdiff_t>(i) * stride_);
 }
 
-S21Matrix S21Matrix::Minor(int row, int col) const {
-  S21Matrix minor(cols_ - 1, rows_ - 1);
+template <typename T>
+bool S21BasicMatrix<T>::IsContiguous(void) const noexcept {
+  return (stride_ == cols_);
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::IsInline(void) const noexcept {
+  return (storage_ == Storage::kInline);
+}
+
+template <typename T>
+std::size_t S21BasicMatrix<T>::capacity(void) const noexcept {
+  return (static_cast<std::size_t>(rows_) * stride_);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Minor(int row, int col) const {
+  S21BasicMatrix minor(cols_ - 1, rows_ - 1);
   for (int i = 0, k = 0; i < rows_ - 1; ++i, ++k) {
     for (int j = 0, l = 0; j < cols_ - 1; ++j, ++l) {
       if (k == row) {
@@ -365,9 +681,174 @@ S21Matrix S21Matrix::Minor(int row, int col) const {
       if (l == col) {
         ++l;
       }
-      minor.matrix_[i][j] = matrix_[k][l];
+      minor.Row(i)[j] = Row(k)[l];
     }
   }
 
   return (minor);
 }
+
+// LU factorization with partial pivoting on a scratch copy: the determinant
+// is the product of the pivots, negated once per row interchange. The
+// trailing update of each step is split into row panels across the pool.
+template <typename T>
+T S21BasicMatrix<T>::LuDeterminant(void) const {
+  S21BasicMatrix lu(*this);
+  int n = rows_;
+  T det = T(1);
+  s21::ThreadPool& pool = s21::ThreadPool::Instance();
+  int grain = n < kParallelMinSize ? n : kParallelGrain;
+
+  for (int k = 0; k < n && det != T(0); ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < n; ++i) {
+      if (std::abs(lu.Row(i)[k]) > std::abs(lu.Row(pivot)[k])) {
+        pivot = i;
+      }
+    }
+
+    if (lu.Row(pivot)[k] == T(0)) {
+      det = T(0);
+    } else {
+      if (pivot != k) {
+        std::swap_ranges(lu.Row(k) + k, lu.Row(k) + n,
+                         lu.Row(pivot) + k);
+        det = -det;
+      }
+      T* row_k = lu.Row(k);
+      det *= row_k[k];
+      pool.ParallelFor(n - k - 1, grain, [&](int begin, int end) {
+        for (int i = k + 1 + begin; i < k + 1 + end; ++i) {
+          T* row_i = lu.Row(i);
+          T factor = row_i[k] / row_k[k];
+          for (int j = k + 1; j < n; ++j) {
+            row_i[j] -= factor * row_k[j];
+          }
+        }
+      });
+    }
+  }
+
+  return (det);
+}
+
+// Inverts the square matrix and computes its determinant on the way, or
+// returns false when it is singular. Large double matrices are factored
+// blockwise and solved against the identity, both of which spend most of
+// their time in GEMM; the rest are inverted by in-place Gauss-Jordan
+// elimination with partial pivoting, whose determinant is the product of the
+// pivots, negated once per row interchange. Row interchanges are recorded
+// and undone as column swaps at the end, so the result is the only matrix
+// buffer allocated.
+template <typename T>
+bool S21BasicMatrix<T>::Invert(S21BasicMatrix& inverse, T& det) const {
+  if constexpr (kIsDouble<T>) {
+    if (rows_ >= S21LU::kBlockedMinSize) {
+      S21LU lu(*this);
+      if (lu.IsSingular()) {
+        return (false);
+      }
+      inverse = lu.Inverse();
+      det = lu.Determinant();
+      return (true);
+    }
+  }
+
+  int n = rows_;
+  inverse = *this;
+  det = T(1);
+  std::vector<int> pivots(n);
+  typedef typename RealOf<T>::type Real;
+  Real tolerance = n * std::numeric_limits<Real>::epsilon() * MaxAbs(inverse);
+  s21::ThreadPool& pool = s21::ThreadPool::Instance();
+  int grain = n < kParallelMinSize ? n : kParallelGrain;
+
+  for (int k = 0; k < n; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < n; ++i) {
+      if (std::abs(inverse.Row(i)[k]) > std::abs(inverse.Row(pivot)[k])) {
+        pivot = i;
+      }
+    }
+    if (std::abs(inverse.Row(pivot)[k]) <= tolerance) {
+      return (false);
+    }
+    pivots[k] = pivot;
+    if (pivot != k) {
+      std::swap_ranges(inverse.Row(k), inverse.Row(k) + n,
+                       inverse.Row(pivot));
+      det = -det;
+    }
+
+    T* row_k = inverse.Row(k);
+    det *= row_k[k];
+    T scale = T(1) / row_k[k];
+    row_k[k] = T(1);
+    for (int j = 0; j < n; ++j) {
+      row_k[j] *= scale;
+    }
+    pool.ParallelFor(n, grain, [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        T* row_i = inverse.Row(i);
+        T factor = row_i[k];
+        if (i != k && factor != T(0)) {
+          row_i[k] = T(0);
+          for (int j = 0; j < n; ++j) {
+            row_i[j] -= factor * row_k[j];
+          }
+        }
+      }
+    });
+  }
+
+  for (int k = n - 1; k >= 0; --k) {
+    if (pivots[k] != k) {
+      for (int i = 0; i < n; ++i) {
+        std::swap(inverse.Row(i)[k], inverse.Row(i)[pivots[k]]);
+      }
+    }
+  }
+
+  return (true);
+}
+
+// Strassen's recursion is implemented for double elements only; the other
+// types always take the blocked product.
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Product(const S21BasicMatrix& lhs,
+                                             const S21BasicMatrix& rhs,
+                                             Multiplication multiplication) {
+  if (lhs.cols_ != rhs.rows_) {
+    throw std::invalid_argument("The matrices are incompatible.");
+  }
+
+  s21::OperationScope scope(S21MatrixStats::Operation::kMulMatrix,
+                            lhs.size() + rhs.size());
+  S21BasicMatrix product(lhs.rows_, rhs.cols_);
+  bool strassen = multiplication == Multiplication::kStrassen;
+  if constexpr (kIsDouble<T>) {
+    if (strassen) {
+      s21::StrassenGemm(lhs.rows_, rhs.cols_, lhs.cols_, lhs.data_,
+                        lhs.stride_, rhs.data_, rhs.stride_, product.data_,
+                        product.stride_);
+    }
+  } else {
+    strassen = false;
+  }
+  if (!strassen) {
+    s21::Gemm(lhs.rows_, rhs.cols_, lhs.cols_, lhs.data_, lhs.stride_, 1,
+              rhs.data_, rhs.stride_, 1, product.data_, product.stride_, 1);
+  }
+
+  return (product);
+}
+
+template <typename T>
+std::size_t S21BasicMatrix<T>::size(void) const noexcept {
+  return (static_cast<std::size_t>(rows_) * cols_);
+}
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
+template class S21BasicMatrix<std::complex<double>>;
@@ -0,0 +1,252 @@
+#include "s21_matrix_stats.h"
+
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+
+#include "s21_instrument.h"
+
+const std::uint64_t
+    S21MatrixStats::kLatencyBoundsNs[S21MatrixStats::kLatencyBuckets - 1] = {
+        100ull,     1000ull,      10000ull,      100000ull,     1000000ull,
+        10000000ull, 100000000ull, 1000000000ull, 10000000000ull};
+
+namespace {
+
+const char* const kOperationNames[S21MatrixStats::kOperations] = {
+    "allocate_matrix", "copy_matrix",      "eq_matrix",   "sum_matrix",
+    "sub_matrix",      "mul_number",       "mul_matrix",  "transpose",
+    "calc_complements", "determinant",     "inverse_matrix"};
+
+#ifdef S21_MATRIX_INSTRUMENT
+
+// Every operation on its own cache line, so that threads running different
+// operations do not contend.
+struct alignas(64) AtomicCounters {
+  std::atomic<std::uint64_t> calls;
+  std::atomic<std::uint64_t> elements;
+  std::atomic<std::uint64_t> allocations;
+  std::atomic<std::uint64_t> bytes_allocated;
+  std::atomic<std::uint64_t> total_ns;
+  std::atomic<std::uint64_t> latency_buckets[S21MatrixStats::kLatencyBuckets];
+};
+
+AtomicCounters counters[S21MatrixStats::kOperations];
+
+// Running totals of this thread; a scope counts their growth.
+thread_local std::uint64_t thread_allocations = 0;
+thread_local std::uint64_t thread_bytes = 0;
+
+int LatencyBucket(std::uint64_t ns) noexcept {
+  int bucket = 0;
+  while (bucket < S21MatrixStats::kLatencyBuckets - 1 &&
+         ns > S21MatrixStats::kLatencyBoundsNs[bucket]) {
+    ++bucket;
+  }
+
+  return (bucket);
+}
+
+void Add(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept {
+  counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+std::uint64_t Load(const std::atomic<std::uint64_t>& counter) noexcept {
+  return (counter.load(std::memory_order_relaxed));
+}
+
+#endif  // S21_MATRIX_INSTRUMENT
+
+std::string Seconds(std::uint64_t ns) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.9g", static_cast<double>(ns) / 1e9);
+
+  return (buffer);
+}
+
+std::string Bound(int bucket) {
+  std::string bound = "+Inf";
+  if (bucket < S21MatrixStats::kLatencyBuckets - 1) {
+    bound = Seconds(S21MatrixStats::kLatencyBoundsNs[bucket]);
+  }
+
+  return (bound);
+}
+
+}  // namespace
+
+#ifdef S21_MATRIX_INSTRUMENT
+
+namespace s21 {
+
+OperationScope::OperationScope(S21MatrixStats::Operation operation,
+                               std::size_t elements) noexcept
+    : operation_(static_cast<int>(operation)),
+      elements_(elements),
+      allocations_(thread_allocations),
+      bytes_(thread_bytes),
+      start_(std::chrono::steady_clock::now()) {}
+
+OperationScope::~OperationScope(void) {
+  std::uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - start_)
+                         .count();
+  AtomicCounters& counter = counters[operation_];
+  Add(counter.calls, 1);
+  Add(counter.elements, elements_);
+  Add(counter.allocations, thread_allocations - allocations_);
+  Add(counter.bytes_allocated, thread_bytes - bytes_);
+  Add(counter.total_ns, ns);
+  Add(counter.latency_buckets[LatencyBucket(ns)], 1);
+}
+
+void CountAllocation(std::size_t bytes) noexcept {
+  ++thread_allocations;
+  thread_bytes += bytes;
+}
+
+}  // namespace s21
+
+#endif  // S21_MATRIX_INSTRUMENT
+
+S21MatrixStats::S21MatrixStats(void) noexcept : counters_() {}
+
+bool S21MatrixStats::enabled(void) noexcept {
+#ifdef S21_MATRIX_INSTRUMENT
+  return (true);
+#else
+  return (false);
+#endif
+}
+
+S21MatrixStats S21MatrixStats::Snapshot(void) noexcept {
+  S21MatrixStats stats;
+#ifdef S21_MATRIX_INSTRUMENT
+  for (int op = 0; op < kOperations; ++op) {
+    const AtomicCounters& counter = counters[op];
+    Counters& snapshot = stats.counters_[op];
+    snapshot.calls = Load(counter.calls);
+    snapshot.elements = Load(counter.elements);
+    snapshot.allocations = Load(counter.allocations);
+    snapshot.bytes_allocated = Load(counter.bytes_allocated);
+    snapshot.total_ns = Load(counter.total_ns);
+    for (int b = 0; b < kLatencyBuckets; ++b) {
+      snapshot.latency_buckets[b] = Load(counter.latency_buckets[b]);
+    }
+  }
+#endif
+
+  return (stats);
+}
+
+void S21MatrixStats::Reset(void) noexcept {
+#ifdef S21_MATRIX_INSTRUMENT
+  for (AtomicCounters& counter : counters) {
+    counter.calls.store(0, std::memory_order_relaxed);
+    counter.elements.store(0, std::memory_order_relaxed);
+    counter.allocations.store(0, std::memory_order_relaxed);
+    counter.bytes_allocated.store(0, std::memory_order_relaxed);
+    counter.total_ns.store(0, std::memory_order_relaxed);
+    for (std::atomic<std::uint64_t>& bucket : counter.latency_buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+#endif
+}
+
+const char* S21MatrixStats::Name(Operation operation) noexcept {
+  int op = static_cast<int>(operation);
+  return (op >= 0 && op < kOperations ? kOperationNames[op] : "unknown");
+}
+
+const S21MatrixStats::Counters& S21MatrixStats::operator[](
+    Operation operation) const {
+  int op = static_cast<int>(operation);
+  if (op < 0 || op >= kOperations) {
+    throw std::out_of_range("Index outside the range of operations.");
+  }
+
+  return (counters_[op]);
+}
+
+std::string S21MatrixStats::ToJson(void) const {
+  std::string json = "{\n  \"enabled\": ";
+  json += enabled() ? "true" : "false";
+  json += ",\n  \"operations\": {";
+  for (int op = 0; op < kOperations; ++op) {
+    const Counters& counter = counters_[op];
+    json += op == 0 ? "\n" : ",\n";
+    json += "    \"" + std::string(kOperationNames[op]) + "\": {";
+    json += "\"calls\": " + std::to_string(counter.calls);
+    json += ", \"elements\": " + std::to_string(counter.elements);
+    json += ", \"allocations\": " + std::to_string(counter.allocations);
+    json += ", \"bytes_allocated\": " + std::to_string(counter.bytes_allocated);
+    json += ", \"total_seconds\": " + Seconds(counter.total_ns);
+    json += ", \"latency_buckets\": [";
+    for (int b = 0; b < kLatencyBuckets; ++b) {
+      std::string bound = Bound(b);
+      if (b == kLatencyBuckets - 1) {
+        bound = "\"" + bound + "\"";
+      }
+      json += b == 0 ? "" : ", ";
+      json += "{\"le\": " + bound +
+              ", \"count\": " + std::to_string(counter.latency_buckets[b]) +
+              "}";
+    }
+    json += "]}";
+  }
+  json += "\n  }\n}\n";
+
+  return (json);
+}
+
+std::string S21MatrixStats::ToPrometheus(void) const {
+  struct Metric {
+    const char* name;
+    const char* help;
+    std::uint64_t Counters::*value;
+  };
+  const Metric metrics[] = {
+      {"s21_matrix_calls_total", "Calls of each S21Matrix operation.",
+       &Counters::calls},
+      {"s21_matrix_elements_total",
+       "Operand elements read by each S21Matrix operation.",
+       &Counters::elements},
+      {"s21_matrix_allocations_total",
+       "Matrix allocations made during each S21Matrix operation.",
+       &Counters::allocations},
+      {"s21_matrix_allocated_bytes_total",
+       "Bytes of matrix storage allocated during each S21Matrix operation.",
+       &Counters::bytes_allocated}};
+
+  std::string text;
+  for (const Metric& metric : metrics) {
+    text += "# HELP " + std::string(metric.name) + " " + metric.help + "\n";
+    text += "# TYPE " + std::string(metric.name) + " counter\n";
+    for (int op = 0; op < kOperations; ++op) {
+      text += std::string(metric.name) + "{operation=\"" +
+              kOperationNames[op] + "\"} " +
+              std::to_string(counters_[op].*metric.value) + "\n";
+    }
+  }
+
+  const std::string histogram = "s21_matrix_operation_duration_seconds";
+  text += "# HELP " + histogram + " Latency of each S21Matrix operation.\n";
+  text += "# TYPE " + histogram + " histogram\n";
+  for (int op = 0; op < kOperations; ++op) {
+    const Counters& counter = counters_[op];
+    std::string label = "{operation=\"" + std::string(kOperationNames[op]);
+    std::uint64_t cumulative = 0;
+    for (int b = 0; b < kLatencyBuckets; ++b) {
+      cumulative += counter.latency_buckets[b];
+      text += histogram + "_bucket" + label + "\",le=\"" + Bound(b) + "\"} " +
+              std::to_string(cumulative) + "\n";
+    }
+    text += histogram + "_sum" + label + "\"} " + Seconds(counter.total_ns) +
+            "\n";
+    text += histogram + "_count" + label + "\"} " +
+            std::to_string(cumulative) + "\n";
+  }
+
+  return (text);
+}
@@ -0,0 +1,233 @@
+#include "s21_matrix_view.h"
+
+#include <stdexcept>
+
+#include "s21_gemm.h"
+#include "s21_kernels.h"
+
+// Read-only views.
+
+S21ConstMatrixView::S21ConstMatrixView(const double* data, int rows, int cols,
+                                       std::ptrdiff_t row_stride,
+                                       std::ptrdiff_t col_stride)
+    : data_(data),
+      rows_(rows),
+      cols_(cols),
+      row_stride_(row_stride),
+      col_stride_(col_stride) {
+  if (rows < 0) {
+    throw std::invalid_argument("The number of rows is negative.");
+  }
+  if (cols < 0) {
+    throw std::invalid_argument("The number of columns is negative.");
+  }
+}
+
+S21ConstMatrixView::S21ConstMatrixView(const S21Matrix& matrix) noexcept
+    : S21ConstMatrixView(matrix.View()) {}
+
+S21ConstMatrixView S21ConstMatrixView::Block(int row, int col, int rows,
+                                             int cols) const {
+  CheckBlock(row, col, rows, cols);
+
+  return (S21ConstMatrixView(data_ + row * row_stride_ + col * col_stride_,
+                             rows, cols, row_stride_, col_stride_));
+}
+
+S21ConstMatrixView S21ConstMatrixView::Row(int i) const {
+  return (Block(i, 0, 1, cols_));
+}
+
+S21ConstMatrixView S21ConstMatrixView::Col(int j) const {
+  return (Block(0, j, rows_, 1));
+}
+
+S21ConstMatrixView S21ConstMatrixView::Transposed(void) const noexcept {
+  S21ConstMatrixView transposed(*this);
+  transposed.rows_ = cols_;
+  transposed.cols_ = rows_;
+  transposed.row_stride_ = col_stride_;
+  transposed.col_stride_ = row_stride_;
+
+  return (transposed);
+}
+
+bool S21ConstMatrixView::EqMatrix(
+    const S21ConstMatrixView& other) const noexcept {
+  bool result = true;
+
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    result = false;
+  } else if (IsContiguous() && other.IsContiguous()) {
+    result = s21::EqualKernel(data_, other.data_,
+                              static_cast<std::size_t>(rows_) * cols_,
+                              S21Matrix::kEps);
+  } else if (HasContiguousRows() && other.HasContiguousRows()) {
+    for (int i = 0; result && i < rows_; ++i) {
+      result = s21::EqualKernel(data_ + i * row_stride_,
+                                other.data_ + i * other.row_stride(), cols_,
+                                S21Matrix::kEps);
+    }
+  } else {
+    for (int i = 0; result && i < rows_; ++i) {
+      for (int j = 0; result && j < cols_; ++j) {
+        double diff = Coeff(i, j) - other.Coeff(i, j);
+        result = diff <= S21Matrix::kEps && -diff <= S21Matrix::kEps;
+      }
+    }
+  }
+
+  return (result);
+}
+
+const double& S21ConstMatrixView::operator()(int i, int j) const {
+  if (i < 0 || i >= rows_) {
+    throw std::out_of_range("Index outside the range of rows.");
+  }
+  if (j < 0 || j >= cols_) {
+    throw std::out_of_range("Index outside the range of columns.");
+  }
+
+  return (data_[i * row_stride_ + j * col_stride_]);
+}
+
+void S21ConstMatrixView::CheckBlock(int row, int col, int rows,
+                                    int cols) const {
+  if (row < 0 || rows < 0 || row > rows_ - rows) {
+    throw std::out_of_range("The block is outside the range of rows.");
+  }
+  if (col < 0 || cols < 0 || col > cols_ - cols) {
+    throw std::out_of_range("The block is outside the range of columns.");
+  }
+}
+
+bool S21ConstMatrixView::IsContiguous(void) const noexcept {
+  return (col_stride_ == 1 && (row_stride_ == cols_ || rows_ == 1));
+}
+
+// Writable views.
+
+S21MatrixView::S21MatrixView(double* data, int rows, int cols,
+                             std::ptrdiff_t row_stride,
+                             std::ptrdiff_t col_stride)
+    : S21ConstMatrixView(data, rows, cols, row_stride, col_stride) {}
+
+S21MatrixView::S21MatrixView(S21Matrix& matrix) noexcept
+    : S21MatrixView(matrix.View()) {}
+
+S21MatrixView::S21MatrixView(const S21ConstMatrixView& view) noexcept
+    : S21ConstMatrixView(view) {}
+
+S21MatrixView S21MatrixView::Block(int row, int col, int rows,
+                                   int cols) const {
+  return (S21MatrixView(S21ConstMatrixView::Block(row, col, rows, cols)));
+}
+
+S21MatrixView S21MatrixView::Row(int i) const {
+  return (S21MatrixView(S21ConstMatrixView::Row(i)));
+}
+
+S21MatrixView S21MatrixView::Col(int j) const {
+  return (S21MatrixView(S21ConstMatrixView::Col(j)));
+}
+
+S21MatrixView S21MatrixView::Transposed(void) const noexcept {
+  return (S21MatrixView(S21ConstMatrixView::Transposed()));
+}
+
+void S21MatrixView::SumMatrix(const S21ConstMatrixView& other) const {
+  if (rows_ != other.rows() || cols_ != other.cols()) {
+    throw std::invalid_argument("Different matrix dimensions.");
+  }
+
+  const double* src = other.data();
+  if (IsContiguous() && other.IsContiguous()) {
+    s21::AddKernel(data(), src, static_cast<std::size_t>(rows_) * cols_);
+  } else if (HasContiguousRows() && other.HasContiguousRows()) {
+    for (int i = 0; i < rows_; ++i) {
+      s21::AddKernel(data() + i * row_stride_, src + i * other.row_stride(),
+                     cols_);
+    }
+  } else {
+    Assign(*this + other);
+  }
+}
+
+void S21MatrixView::SubMatrix(const S21ConstMatrixView& other) const {
+  if (rows_ != other.rows() || cols_ != other.cols()) {
+    throw std::invalid_argument("Different matrix dimensions.");
+  }
+
+  const double* src = other.data();
+  if (IsContiguous() && other.IsContiguous()) {
+    s21::SubKernel(data(), src, static_cast<std::size_t>(rows_) * cols_);
+  } else if (HasContiguousRows() && other.HasContiguousRows()) {
+    for (int i = 0; i < rows_; ++i) {
+      s21::SubKernel(data() + i * row_stride_, src + i * other.row_stride(),
+                     cols_);
+    }
+  } else {
+    Assign(*this - other);
+  }
+}
+
+void S21MatrixView::MulMatrix(double num) const noexcept {
+  if (IsContiguous()) {
+    s21::ScaleKernel(data(), num, static_cast<std::size_t>(rows_) * cols_);
+  } else if (HasContiguousRows()) {
+    for (int i = 0; i < rows_; ++i) {
+      s21::ScaleKernel(data() + i * row_stride_, num, cols_);
+    }
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        data()[i * row_stride_ + j * col_stride_] *= num;
+      }
+    }
+  }
+}
+
+void S21MatrixView::AddProduct(const S21ConstMatrixView& lhs,
+                               const S21ConstMatrixView& rhs) const {
+  if (lhs.cols() != rhs.rows()) {
+    throw std::invalid_argument("The matrices are incompatible.");
+  }
+  if (rows_ != lhs.rows() || cols_ != rhs.cols()) {
+    throw std::invalid_argument("Different matrix dimensions.");
+  }
+
+  if (rows_ > 0 && cols_ > 0 && lhs.cols() > 0) {
+    s21::Gemm(rows_, cols_, lhs.cols(), lhs.data(), lhs.row_stride(),
+              lhs.col_stride(), rhs.data(), rhs.row_stride(),
+              rhs.col_stride(), data(), row_stride_, col_stride_);
+  }
+}
+
+double& S21MatrixView::operator()(int i, int j) const {
+  return (const_cast<double&>(S21ConstMatrixView::operator()(i, j)));
+}
+
+// Products of views.
+
+S21Matrix operator*(const S21ConstMatrixView& lhs,
+                    const S21ConstMatrixView& rhs) {
+  if (lhs.cols() != rhs.rows()) {
+    throw std::invalid_argument("The matrices are incompatible.");
+  }
+  if (lhs.rows() == 0 || rhs.cols() == 0) {
+    throw std::invalid_argument("The product has no rows or columns.");
+  }
+
+  S21Matrix product(lhs.rows(), rhs.cols());
+  product.View().AddProduct(lhs, rhs);
+
+  return (product);
+}
+
+S21Matrix operator*(const S21Matrix& lhs, const S21ConstMatrixView& rhs) {
+  return (lhs.View() * rhs);
+}
+
+S21Matrix operator*(const S21ConstMatrixView& lhs, const S21Matrix& rhs) {
+  return (lhs * rhs.View());
+}
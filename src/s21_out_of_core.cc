@@ -0,0 +1,143 @@
+#include "s21_out_of_core.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_gemm.h"
+#include "s21_matrix_file.h"
+
+namespace {
+
+// Buffers held at once: two tiles of each operand, so that the next pair can
+// be read while the current one is multiplied, and one tile of the result.
+const int kTilesInMemory = 5;
+
+struct Step {
+  int row;
+  int col;
+  int depth;
+  int rows;
+  int cols;
+  int depths;
+};
+
+bool SameFile(const s21::File& file, const std::string& path) {
+  struct stat st;
+  struct stat other;
+  return (stat(path.c_str(), &st) == 0 && fstat(file.fd(), &other) == 0 &&
+          st.st_dev == other.st_dev && st.st_ino == other.st_ino);
+}
+
+}  // namespace
+
+const std::size_t S21OutOfCoreMultiplier::kDefaultMemoryBudget = 256 << 20;
+const int S21OutOfCoreMultiplier::kMinTileSize = 8;
+
+S21OutOfCoreMultiplier::S21OutOfCoreMultiplier(void)
+    : S21OutOfCoreMultiplier(kDefaultMemoryBudget) {}
+
+S21OutOfCoreMultiplier::S21OutOfCoreMultiplier(std::size_t memory_budget) {
+  set_memory_budget(memory_budget);
+}
+
+std::size_t S21OutOfCoreMultiplier::memory_budget(void) const noexcept {
+  return (memory_budget_);
+}
+
+void S21OutOfCoreMultiplier::set_memory_budget(std::size_t memory_budget) {
+  double elements =
+      static_cast<double>(memory_budget) / sizeof(double) / kTilesInMemory;
+  double tile_size = std::min(std::floor(std::sqrt(elements)), 1.0e9);
+  if (tile_size < kMinTileSize) {
+    throw std::invalid_argument("The memory budget is too small.");
+  }
+
+  memory_budget_ = memory_budget;
+  tile_size_ = static_cast<int>(tile_size);
+}
+
+int S21OutOfCoreMultiplier::tile_size(void) const noexcept {
+  return (tile_size_);
+}
+
+void S21OutOfCoreMultiplier::Multiply(const std::string& lhs,
+                                      const std::string& rhs,
+                                      const std::string& result) const {
+  s21::File a = s21::File::OpenForReading(lhs);
+  s21::File b = s21::File::OpenForReading(rhs);
+  s21::FileHeader a_header = a.ReadHeader();
+  s21::FileHeader b_header = b.ReadHeader();
+  if (a_header.cols != b_header.rows) {
+    throw std::invalid_argument("The matrices are incompatible.");
+  }
+  if (SameFile(a, result) || SameFile(b, result)) {
+    throw std::invalid_argument("The result must not overwrite an operand.");
+  }
+
+  int m = static_cast<int>(a_header.rows);
+  int n = static_cast<int>(b_header.cols);
+  int k = static_cast<int>(a_header.cols);
+  int tm = std::min(tile_size_, m);
+  int tn = std::min(tile_size_, n);
+  int tk = std::min(tile_size_, k);
+
+  s21::File c = s21::File::Create(result);
+  s21::FileHeader c_header = s21::MakeFileHeader(m, n, n);
+  c.Resize(c_header.data_offset +
+           static_cast<std::uint64_t>(m) * n * sizeof(double));
+
+  // Each tile of the result accumulates over the whole inner dimension
+  // before it is written, so every result element is written once.
+  std::vector<Step> steps;
+  for (int i = 0; i < m; i += tm) {
+    for (int j = 0; j < n; j += tn) {
+      for (int p = 0; p < k; p += tk) {
+        steps.push_back({i, j, p, std::min(tm, m - i), std::min(tn, n - j),
+                         std::min(tk, k - p)});
+      }
+    }
+  }
+
+  std::vector<double> a_tiles[2];
+  std::vector<double> b_tiles[2];
+  for (int buffer = 0; buffer < 2; ++buffer) {
+    a_tiles[buffer].resize(static_cast<std::size_t>(tm) * tk);
+    b_tiles[buffer].resize(static_cast<std::size_t>(tk) * tn);
+  }
+  std::vector<double> c_tile(static_cast<std::size_t>(tm) * tn);
+  auto read_tiles = [&](std::size_t index) {
+    const Step& step = steps[index];
+    a.ReadBlock(a_header, step.row, step.depth, step.rows, step.depths,
+                a_tiles[index % 2].data(), step.depths);
+    b.ReadBlock(b_header, step.depth, step.col, step.depths, step.cols,
+                b_tiles[index % 2].data(), step.cols);
+  };
+
+  std::future<void> prefetch = std::async(std::launch::async, read_tiles, 0);
+  for (std::size_t index = 0; index < steps.size(); ++index) {
+    const Step& step = steps[index];
+    prefetch.get();
+    if (index + 1 < steps.size()) {
+      prefetch = std::async(std::launch::async, read_tiles, index + 1);
+    }
+
+    if (step.depth == 0) {
+      std::fill(c_tile.begin(), c_tile.end(), 0.0);
+    }
+    s21::Gemm(step.rows, step.cols, step.depths, a_tiles[index % 2].data(),
+              step.depths, 1, b_tiles[index % 2].data(), step.cols, 1,
+              c_tile.data(), step.cols, 1);
+    if (step.depth + step.depths == k) {
+      c.WriteBlock(c_header, step.row, step.col, step.rows, step.cols,
+                   c_tile.data(), step.cols);
+    }
+  }
+
+  c_header.checksum = c.ComputeChecksum(c_header);
+  c.Write(&c_header, sizeof(c_header), 0);
+}
@@ -0,0 +1,442 @@
+#include "s21_sparse_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_kernels.h"
+#include "s21_matrix_view.h"
+
+// Constructors.
+
+S21SparseMatrix::S21SparseMatrix(void)
+    : S21SparseMatrix(S21Matrix::kDefaultRows, S21Matrix::kDefaultCols) {}
+
+S21SparseMatrix::S21SparseMatrix(int rows, int cols, Format format)
+    : rows_(rows), cols_(cols), format_(format) {
+  if (rows < 1) {
+    throw std::invalid_argument("The number of rows is less than 1.");
+  }
+  if (cols < 1) {
+    throw std::invalid_argument("The number of columns is less than 1.");
+  }
+
+  offsets_.assign(outer() + 1, 0);
+}
+
+S21SparseMatrix::S21SparseMatrix(const S21Matrix& dense, Format format,
+                                 double threshold)
+    : S21SparseMatrix(dense.rows(), dense.cols(), format) {
+  S21ConstMatrixView view = dense.View();
+  if (format_ == Format::kCsc) {
+    view = view.Transposed();
+  }
+
+  for (int k = 0; k < outer(); ++k) {
+    for (int l = 0; l < inner(); ++l) {
+      double value = view.Coeff(k, l);
+      if (fabs(value) > threshold) {
+        indices_.push_back(l);
+        values_.push_back(value);
+      }
+    }
+    offsets_[k + 1] = values_.size();
+  }
+}
+
+S21SparseMatrix S21SparseMatrix::FromTriplets(
+    int rows, int cols, const std::vector<Triplet>& triplets, Format format) {
+  S21SparseMatrix result(rows, cols, format);
+  bool csr = format == Format::kCsr;
+  for (const Triplet& t : triplets) {
+    if (t.row < 0 || t.row >= rows) {
+      throw std::out_of_range("Index outside the range of rows.");
+    }
+    if (t.col < 0 || t.col >= cols) {
+      throw std::out_of_range("Index outside the range of columns.");
+    }
+    ++result.offsets_[(csr ? t.row : t.col) + 1];
+  }
+
+  // Bucket the entries by outer index, then sort each line and sum duplicates.
+  std::vector<std::size_t> bucket(result.offsets_.size());
+  std::partial_sum(result.offsets_.begin(), result.offsets_.end(),
+                   bucket.begin());
+  std::vector<std::size_t> next(bucket.begin(), bucket.end() - 1);
+  std::vector<std::pair<int, double>> entries(triplets.size());
+  for (const Triplet& t : triplets) {
+    entries[next[csr ? t.row : t.col]++] =
+        std::make_pair(csr ? t.col : t.row, t.value);
+  }
+
+  result.indices_.reserve(entries.size());
+  result.values_.reserve(entries.size());
+  for (int k = 0; k < result.outer(); ++k) {
+    auto first = entries.begin() + bucket[k];
+    auto last = entries.begin() + bucket[k + 1];
+    std::sort(first, last, [](const auto& a, const auto& b) {
+      return (a.first < b.first);
+    });
+    while (first != last) {
+      int index = first->first;
+      double sum = 0.0;
+      for (; first != last && first->first == index; ++first) {
+        sum += first->second;
+      }
+      if (sum != 0.0) {
+        result.indices_.push_back(index);
+        result.values_.push_back(sum);
+      }
+    }
+    result.offsets_[k + 1] = result.values_.size();
+  }
+
+  return (result);
+}
+
+// Accessors.
+
+int S21SparseMatrix::rows(void) const noexcept { return (rows_); }
+
+int S21SparseMatrix::cols(void) const noexcept { return (cols_); }
+
+S21SparseMatrix::Format S21SparseMatrix::format(void) const noexcept {
+  return (format_);
+}
+
+std::size_t S21SparseMatrix::nonzeros(void) const noexcept {
+  return (values_.size());
+}
+
+const std::vector<std::size_t>& S21SparseMatrix::offsets(
+    void) const noexcept {
+  return (offsets_);
+}
+
+const std::vector<int>& S21SparseMatrix::indices(void) const noexcept {
+  return (indices_);
+}
+
+const std::vector<double>& S21SparseMatrix::values(void) const noexcept {
+  return (values_);
+}
+
+// Conversions.
+
+S21Matrix S21SparseMatrix::ToDense(void) const {
+  S21Matrix dense(rows_, cols_);
+  S21MatrixView view = dense.View();
+  if (format_ == Format::kCsc) {
+    view = view.Transposed();
+  }
+
+  for (int k = 0; k < outer(); ++k) {
+    for (std::size_t p = offsets_[k]; p < offsets_[k + 1]; ++p) {
+      view(k, indices_[p]) = values_[p];
+    }
+  }
+
+  return (dense);
+}
+
+// Counting sort on the inner index: walking the lines in order emits every
+// line of the result already sorted.
+S21SparseMatrix S21SparseMatrix::ToFormat(Format format) const {
+  if (format == format_) {
+    return (*this);
+  }
+
+  S21SparseMatrix result(rows_, cols_, format);
+  for (int index : indices_) {
+    ++result.offsets_[index + 1];
+  }
+  std::partial_sum(result.offsets_.begin(), result.offsets_.end(),
+                   result.offsets_.begin());
+
+  std::vector<std::size_t> next(result.offsets_.begin(),
+                                result.offsets_.end() - 1);
+  result.indices_.resize(nonzeros());
+  result.values_.resize(nonzeros());
+  for (int k = 0; k < outer(); ++k) {
+    for (std::size_t p = offsets_[k]; p < offsets_[k + 1]; ++p) {
+      std::size_t q = next[indices_[p]]++;
+      result.indices_[q] = k;
+      result.values_[q] = values_[p];
+    }
+  }
+
+  return (result);
+}
+
+// The CSR arrays of a matrix are the CSC arrays of its transpose, so only
+// the dimensions and the format change.
+S21SparseMatrix S21SparseMatrix::Transpose(void) const {
+  S21SparseMatrix result(*this);
+  std::swap(result.rows_, result.cols_);
+  result.format_ = format_ == Format::kCsr ? Format::kCsc : Format::kCsr;
+
+  return (result);
+}
+
+// Operations.
+
+bool S21SparseMatrix::EqMatrix(const S21SparseMatrix& other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    return (false);
+  }
+
+  S21SparseMatrix converted;
+  const S21SparseMatrix& rhs = Aligned(other, converted);
+  bool equal = true;
+  for (int k = 0; equal && k < outer(); ++k) {
+    std::size_t p = offsets_[k];
+    std::size_t q = rhs.offsets_[k];
+    while (equal && (p < offsets_[k + 1] || q < rhs.offsets_[k + 1])) {
+      double difference = 0.0;
+      if (q == rhs.offsets_[k + 1] ||
+          (p < offsets_[k + 1] && indices_[p] < rhs.indices_[q])) {
+        difference = values_[p++];
+      } else if (p == offsets_[k + 1] || rhs.indices_[q] < indices_[p]) {
+        difference = rhs.values_[q++];
+      } else {
+        difference = values_[p++] - rhs.values_[q++];
+      }
+      equal = fabs(difference) <= S21Matrix::kEps;
+    }
+  }
+
+  return (equal);
+}
+
+void S21SparseMatrix::SumMatrix(const S21SparseMatrix& other) {
+  Merge(other, 1.0);
+}
+
+void S21SparseMatrix::SubMatrix(const S21SparseMatrix& other) {
+  Merge(other, -1.0);
+}
+
+void S21SparseMatrix::MulMatrix(double num) noexcept {
+  if (num == 0.0) {
+    std::fill(offsets_.begin(), offsets_.end(), 0);
+    indices_.clear();
+    values_.clear();
+  } else {
+    s21::ScaleKernel(values_.data(), num, values_.size());
+  }
+}
+
+std::vector<double> S21SparseMatrix::MulVector(
+    const std::vector<double>& x) const {
+  if (x.size() != static_cast<std::size_t>(cols_)) {
+    throw std::invalid_argument("The matrices are incompatible.");
+  }
+
+  std::vector<double> y(rows_, 0.0);
+  for (int k = 0; k < outer(); ++k) {
+    if (format_ == Format::kCsr) {
+      double sum = 0.0;
+      for (std::size_t p = offsets_[k]; p < offsets_[k + 1]; ++p) {
+        sum += values_[p] * x[indices_[p]];
+      }
+      y[k] = sum;
+    } else {
+      for (std::size_t p = offsets_[k]; p < offsets_[k + 1]; ++p) {
+        y[indices_[p]] += values_[p] * x[k];
+      }
+    }
+  }
+
+  return (y);
+}
+
+// Every stored element a(i, k) adds a(i, k) times row k of dense to row i
+// of the product, whichever way the elements are ordered.
+S21Matrix S21SparseMatrix::MulDense(const S21Matrix& dense) const {
+  if (cols_ != dense.rows()) {
+    throw std::invalid_argument("The matrices are incompatible.");
+  }
+
+  S21Matrix product(rows_, dense.cols());
+  S21MatrixView to = product.View();
+  S21ConstMatrixView from = dense.View();
+  bool csr = format_ == Format::kCsr;
+  for (int k = 0; k < outer(); ++k) {
+    for (std::size_t p = offsets_[k]; p < offsets_[k + 1]; ++p) {
+      int i = csr ? k : indices_[p];
+      int j = csr ? indices_[p] : k;
+      s21::AxpyKernel(to.Row(i).data(), values_[p], from.Row(j).data(),
+                      dense.cols());
+    }
+  }
+
+  return (product);
+}
+
+// Operators.
+
+S21SparseMatrix S21SparseMatrix::operator+(
+    const S21SparseMatrix& other) const {
+  S21SparseMatrix tmp(*this);
+  tmp.SumMatrix(other);
+
+  return (tmp);
+}
+
+S21SparseMatrix S21SparseMatrix::operator-(
+    const S21SparseMatrix& other) const {
+  S21SparseMatrix tmp(*this);
+  tmp.SubMatrix(other);
+
+  return (tmp);
+}
+
+S21SparseMatrix S21SparseMatrix::operator*(double num) const {
+  S21SparseMatrix tmp(*this);
+  tmp.MulMatrix(num);
+
+  return (tmp);
+}
+
+std::vector<double> S21SparseMatrix::operator*(
+    const std::vector<double>& x) const {
+  return (MulVector(x));
+}
+
+S21Matrix S21SparseMatrix::operator*(const S21Matrix& dense) const {
+  return (MulDense(dense));
+}
+
+bool S21SparseMatrix::operator==(const S21SparseMatrix& other) const {
+  return (EqMatrix(other));
+}
+
+S21SparseMatrix& S21SparseMatrix::operator+=(const S21SparseMatrix& other) {
+  SumMatrix(other);
+  return (*this);
+}
+
+S21SparseMatrix& S21SparseMatrix::operator-=(const S21SparseMatrix& other) {
+  SubMatrix(other);
+  return (*this);
+}
+
+S21SparseMatrix& S21SparseMatrix::operator*=(double num) noexcept {
+  MulMatrix(num);
+  return (*this);
+}
+
+double S21SparseMatrix::operator()(int i, int j) const {
+  if (i < 0 || i >= rows_) {
+    throw std::out_of_range("Index outside the range of rows.");
+  }
+  if (j < 0 || j >= cols_) {
+    throw std::out_of_range("Index outside the range of columns.");
+  }
+
+  int k = format_ == Format::kCsr ? i : j;
+  int l = format_ == Format::kCsr ? j : i;
+  auto first = indices_.begin() + offsets_[k];
+  auto last = indices_.begin() + offsets_[k + 1];
+  auto it = std::lower_bound(first, last, l);
+
+  return (it != last && *it == l ? values_[it - indices_.begin()] : 0.0);
+}
+
+// Private methods.
+
+int S21SparseMatrix::outer(void) const noexcept {
+  return (format_ == Format::kCsr ? rows_ : cols_);
+}
+
+int S21SparseMatrix::inner(void) const noexcept {
+  return (format_ == Format::kCsr ? cols_ : rows_);
+}
+
+// Returns other if it is stored in the format of this matrix, and otherwise
+// converts it into converted and returns that.
+const S21SparseMatrix& S21SparseMatrix::Aligned(
+    const S21SparseMatrix& other, S21SparseMatrix& converted) const {
+  if (other.format_ == format_) {
+    return (other);
+  }
+  converted = other.ToFormat(format_);
+
+  return (converted);
+}
+
+// Merges each line of other into the same line of this matrix. Elements that
+// cancel out are dropped so that only nonzeros stay stored.
+void S21SparseMatrix::Merge(const S21SparseMatrix& other, double sign) {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument("Different matrix dimensions.");
+  }
+
+  S21SparseMatrix converted;
+  const S21SparseMatrix& rhs = Aligned(other, converted);
+  std::vector<std::size_t> offsets(offsets_.size(), 0);
+  std::vector<int> indices;
+  std::vector<double> values;
+  indices.reserve(nonzeros() + rhs.nonzeros());
+  values.reserve(nonzeros() + rhs.nonzeros());
+
+  auto emit = [&](int index, double value) {
+    if (value != 0.0) {
+      indices.push_back(index);
+      values.push_back(value);
+    }
+  };
+  for (int k = 0; k < outer(); ++k) {
+    std::size_t p = offsets_[k];
+    std::size_t q = rhs.offsets_[k];
+    while (p < offsets_[k + 1] || q < rhs.offsets_[k + 1]) {
+      if (q == rhs.offsets_[k + 1] ||
+          (p < offsets_[k + 1] && indices_[p] < rhs.indices_[q])) {
+        emit(indices_[p], values_[p]);
+        ++p;
+      } else if (p == offsets_[k + 1] || rhs.indices_[q] < indices_[p]) {
+        emit(rhs.indices_[q], sign * rhs.values_[q]);
+        ++q;
+      } else {
+        emit(indices_[p], values_[p] + sign * rhs.values_[q]);
+        ++p;
+        ++q;
+      }
+    }
+    offsets[k + 1] = values.size();
+  }
+
+  offsets_ = std::move(offsets);
+  indices_ = std::move(indices);
+  values_ = std::move(values);
+}
+
+// Row i of the product is the sum of the rows k of sparse weighted by the
+// elements dense(i, k), so the nonzeros are visited once per row of dense.
+S21Matrix operator*(const S21Matrix& dense, const S21SparseMatrix& sparse) {
+  if (dense.cols() != sparse.rows()) {
+    throw std::invalid_argument("The matrices are incompatible.");
+  }
+
+  S21SparseMatrix csr = sparse.ToFormat(S21SparseMatrix::Format::kCsr);
+  const std::vector<std::size_t>& offsets = csr.offsets();
+  const std::vector<int>& indices = csr.indices();
+  const std::vector<double>& values = csr.values();
+  S21Matrix product(dense.rows(), sparse.cols());
+  S21MatrixView to = product.View();
+  S21ConstMatrixView from = dense.View();
+  for (int i = 0; i < dense.rows(); ++i) {
+    double* row = to.Row(i).data();
+    for (int k = 0; k < dense.cols(); ++k) {
+      double factor = from.Coeff(i, k);
+      for (std::size_t p = offsets[k]; factor != 0.0 && p < offsets[k + 1];
+           ++p) {
+        row[indices[p]] += factor * values[p];
+      }
+    }
+  }
+
+  return (product);
+}
@@ -0,0 +1,151 @@
+#include "s21_strassen.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "s21_gemm.h"
+#include "s21_kernels.h"
+
+namespace s21 {
+
+namespace {
+
+// Like the packing buffers of Gemm, the workspace is kept per thread so
+// that repeated products do not go back to the allocator, unless it is too
+// large to pin for the rest of the thread's life.
+thread_local std::vector<double> strassen_workspace;
+
+std::size_t WorkspaceSize(int m, int n, int k, int crossover) {
+  std::size_t size = 0;
+  if (std::min({m, n, k}) >= crossover) {
+    std::size_t m2 = m / 2;
+    std::size_t n2 = n / 2;
+    std::size_t k2 = k / 2;
+    size = m2 * std::max(k2, n2) + k2 * n2 +
+           WorkspaceSize(m / 2, n / 2, k / 2, crossover);
+  }
+
+  return (size);
+}
+
+void Clear(int rows, int cols, double* z, std::ptrdiff_t rsz) {
+  for (int i = 0; i < rows; ++i) {
+    memset(z + i * rsz, 0, cols * sizeof(double));
+  }
+}
+
+// z = x + y or z = x - y, row by row; z may be the same block as x or y.
+void Combine(int rows, int cols, const double* x, std::ptrdiff_t rsx,
+             const double* y, std::ptrdiff_t rsy, bool subtract, double* z,
+             std::ptrdiff_t rsz) {
+  for (int i = 0; i < rows; ++i) {
+    const double* x_i = x + i * rsx;
+    const double* y_i = y + i * rsy;
+    double* z_i = z + i * rsz;
+    if (z_i == y_i) {
+      if (subtract) {
+        ScaleKernel(z_i, -1.0, cols);
+      }
+      AddKernel(z_i, x_i, cols);
+    } else {
+      if (z_i != x_i) {
+        memcpy(z_i, x_i, cols * sizeof(double));
+      }
+      if (subtract) {
+        SubKernel(z_i, y_i, cols);
+      } else {
+        AddKernel(z_i, y_i, cols);
+      }
+    }
+  }
+}
+
+void Multiply(int m, int n, int k, const double* a, std::ptrdiff_t rsa,
+              const double* b, std::ptrdiff_t rsb, double* c,
+              std::ptrdiff_t rsc, double* work, int crossover) {
+  if (std::min({m, n, k}) < crossover) {
+    Clear(m, n, c, rsc);
+    Gemm(m, n, k, a, rsa, 1, b, rsb, 1, c, rsc, 1);
+    return;
+  }
+
+  int m2 = m / 2;
+  int n2 = n / 2;
+  int k2 = k / 2;
+  const double* a11 = a;
+  const double* a12 = a + k2;
+  const double* a21 = a + m2 * rsa;
+  const double* a22 = a21 + k2;
+  const double* b11 = b;
+  const double* b12 = b + n2;
+  const double* b21 = b + k2 * rsb;
+  const double* b22 = b21 + n2;
+  double* c11 = c;
+  double* c12 = c + n2;
+  double* c21 = c + m2 * rsc;
+  double* c22 = c21 + n2;
+  // x holds the sums of blocks of A and then P1, y the sums of blocks of B.
+  double* x = work;
+  double* y = x + static_cast<std::size_t>(m2) * std::max(k2, n2);
+  double* rest = y + static_cast<std::size_t>(k2) * n2;
+
+  // The schedule of Boyer, Dumas, Pernet and Zhou, which needs no
+  // temporaries besides x, y and the quadrants of C.
+  Combine(m2, k2, a11, rsa, a21, rsa, true, x, k2);  // S3
+  Combine(k2, n2, b22, rsb, b12, rsb, true, y, n2);  // T3
+  Multiply(m2, n2, k2, x, k2, y, n2, c21, rsc, rest, crossover);  // P7
+  Combine(m2, k2, a21, rsa, a22, rsa, false, x, k2);  // S1
+  Combine(k2, n2, b12, rsb, b11, rsb, true, y, n2);   // T1
+  Multiply(m2, n2, k2, x, k2, y, n2, c22, rsc, rest, crossover);  // P5
+  Combine(m2, k2, x, k2, a11, rsa, true, x, k2);   // S2
+  Combine(k2, n2, b22, rsb, y, n2, true, y, n2);   // T2
+  Multiply(m2, n2, k2, x, k2, y, n2, c12, rsc, rest, crossover);  // P6
+  Combine(m2, k2, a12, rsa, x, k2, true, x, k2);   // S4
+  Multiply(m2, n2, k2, x, k2, b22, rsb, c11, rsc, rest, crossover);  // P3
+  Multiply(m2, n2, k2, a11, rsa, b11, rsb, x, n2, rest, crossover);  // P1
+  Combine(m2, n2, x, n2, c12, rsc, false, c12, rsc);     // U2 = P1 + P6
+  Combine(m2, n2, c12, rsc, c21, rsc, false, c21, rsc);  // U3 = U2 + P7
+  Combine(m2, n2, c12, rsc, c22, rsc, false, c12, rsc);  // U4 = U2 + P5
+  Combine(m2, n2, c21, rsc, c22, rsc, false, c22, rsc);  // U7 = U3 + P5
+  Combine(m2, n2, c12, rsc, c11, rsc, false, c12, rsc);  // U5 = U4 + P3
+  Combine(k2, n2, y, n2, b21, rsb, true, y, n2);         // T4
+  Multiply(m2, n2, k2, a22, rsa, y, n2, c11, rsc, rest, crossover);  // P4
+  Combine(m2, n2, c21, rsc, c11, rsc, true, c21, rsc);  // U6 = U3 - P4
+  Multiply(m2, n2, k2, a12, rsa, b21, rsb, c11, rsc, rest, crossover);  // P2
+  Combine(m2, n2, x, n2, c11, rsc, false, c11, rsc);  // U1 = P1 + P2
+
+  // The last row, column and inner index of odd dimensions.
+  if (k % 2) {
+    Gemm(2 * m2, 2 * n2, 1, a + k - 1, rsa, 1, b + (k - 1) * rsb, rsb, 1, c,
+         rsc, 1);
+  }
+  if (n % 2) {
+    Clear(2 * m2, 1, c + n - 1, rsc);
+    Gemm(2 * m2, 1, k, a, rsa, 1, b + n - 1, rsb, 1, c + n - 1, rsc, 1);
+  }
+  if (m % 2) {
+    Clear(1, n, c + (m - 1) * rsc, rsc);
+    Gemm(1, n, k, a + (m - 1) * rsa, rsa, 1, b, rsb, 1, c + (m - 1) * rsc,
+         rsc, 1);
+  }
+}
+
+}  // namespace
+
+void StrassenGemm(int m, int n, int k, const double* a, std::ptrdiff_t rsa,
+                  const double* b, std::ptrdiff_t rsb, double* c,
+                  std::ptrdiff_t rsc, int crossover) {
+  std::size_t size = WorkspaceSize(m, n, k, crossover);
+  if (strassen_workspace.size() < size) {
+    strassen_workspace.resize(size);
+  }
+  Multiply(m, n, k, a, rsa, b, rsb, c, rsc, strassen_workspace.data(),
+           crossover);
+  if (strassen_workspace.capacity() * sizeof(double) >
+      kStrassenWorkspaceMaxBytes) {
+    std::vector<double>().swap(strassen_workspace);
+  }
+}
+
+}  // namespace s21
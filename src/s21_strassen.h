@@ -0,0 +1,31 @@
+#ifndef S21_STRASSEN_H_
+#define S21_STRASSEN_H_
+
+#include <cstddef>
+
+namespace s21 {
+
+// Products whose smallest dimension is below this are left to Gemm; above
+// it a level of recursion saves more than its extra additions cost.
+constexpr int kStrassenCrossover = 256;
+// A calling thread keeps its workspace between products up to this size;
+// larger ones, about 90 MB at order 4096, are released after the product.
+constexpr std::size_t kStrassenWorkspaceMaxBytes = std::size_t(16) << 20;
+
+// C = A * B by Strassen-Winograd recursion: 7 half-size products and 15
+// additions per level instead of 8 products, down to Gemm on blocks smaller
+// than crossover. Odd dimensions are peeled off and finished by Gemm. The
+// operands are row-major with the given row strides, and C must not overlap
+// them. The temporaries of every level are carved from one per-thread
+// workspace, of about (m * max(k, n) + k * n) / 3 elements, which is kept
+// up to kStrassenWorkspaceMaxBytes.
+//
+// The result is not rounded like the standard product: its normwise error
+// bound grows like (n / crossover)^log2(18) instead of n.
+void StrassenGemm(int m, int n, int k, const double* a, std::ptrdiff_t rsa,
+                  const double* b, std::ptrdiff_t rsb, double* c,
+                  std::ptrdiff_t rsc, int crossover = kStrassenCrossover);
+
+}  // namespace s21
+
+#endif  // S21_STRASSEN_H_
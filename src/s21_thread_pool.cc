@@ -0,0 +1,146 @@
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace s21 {
+
+namespace {
+
+// Set on pool workers and on a caller while it runs its share of a job, so
+// that nested parallel loops fall back to running inline.
+thread_local bool in_parallel_region = false;
+
+int DefaultSize(void) {
+  const char* env = std::getenv("S21_MATRIX_THREADS");
+  int size = env != nullptr ? std::atoi(env) : 0;
+  if (size < 1) {
+    size = static_cast<int>(std::thread::hardware_concurrency());
+  }
+
+  return (std::max(size, 1));
+}
+
+}  // namespace
+
+ThreadPool& ThreadPool::Instance(void) {
+  static ThreadPool pool;
+  return (pool);
+}
+
+ThreadPool::ThreadPool(void)
+    : size_(DefaultSize()),
+      stop_(false),
+      generation_(0),
+      function_(nullptr),
+      context_(nullptr),
+      count_(0),
+      chunks_(0),
+      next_chunk_(0),
+      pending_chunks_(0) {}
+
+ThreadPool::~ThreadPool(void) { StopWorkers(); }
+
+int ThreadPool::size(void) const noexcept { return (size_); }
+
+void ThreadPool::Resize(int size) {
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  StopWorkers();
+  size_ = size;
+}
+
+void ThreadPool::Run(int count, int grain, Function function, void* context) {
+  int chunks =
+      std::min(size_.load(), (count + grain - 1) / std::max(grain, 1));
+  std::unique_lock<std::mutex> run_lock(run_mutex_, std::defer_lock);
+  if (chunks < 2 || in_parallel_region || !run_lock.try_lock()) {
+    function(context, 0, count);
+    return;
+  }
+
+  if (workers_.empty()) {
+    StartWorkers();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    function_ = function;
+    context_ = context;
+    count_ = count;
+    chunks_ = chunks;
+    next_chunk_ = 0;
+    pending_chunks_ = chunks;
+    ++generation_;
+  }
+  start_.notify_all();
+
+  in_parallel_region = true;
+  RunChunks();
+  in_parallel_region = false;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return pending_chunks_ == 0; });
+}
+
+void ThreadPool::RunChunks(void) {
+  for (;;) {
+    Function function;
+    void* context;
+    int begin;
+    int end;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (next_chunk_ >= chunks_) {
+        break;
+      }
+      int chunk = next_chunk_++;
+      function = function_;
+      context = context_;
+      begin = static_cast<int>(static_cast<long>(count_) * chunk / chunks_);
+      end = static_cast<int>(static_cast<long>(count_) * (chunk + 1) / chunks_);
+    }
+
+    function(context, begin, end);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--pending_chunks_ == 0) {
+      done_.notify_one();
+    }
+  }
+}
+
+void ThreadPool::WorkerLoop(unsigned long seen) {
+  in_parallel_region = true;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+      if (stop_) {
+        break;
+      }
+      seen = generation_;
+    }
+    RunChunks();
+  }
+}
+
+void ThreadPool::StartWorkers(void) {
+  unsigned long generation = generation_;
+  for (int i = 1; i < size_; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this, generation);
+  }
+}
+
+void ThreadPool::StopWorkers(void) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  stop_ = false;
+}
+
+}  // namespace s21
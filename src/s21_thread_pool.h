@@ -0,0 +1,70 @@
+#ifndef S21_THREAD_POOL_H_
+#define S21_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace s21 {
+
+// Persistent pool of worker threads shared by all matrix operations. The
+// calling thread always takes part in the work, so a pool of size N owns
+// N - 1 workers, and a pool of size 1 runs everything inline.
+class ThreadPool {
+ public:
+  static ThreadPool& Instance(void);
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool(void);
+
+  int size(void) const noexcept;
+  void Resize(int size);
+
+  // Splits [0, count) into contiguous chunks of at least grain iterations
+  // and calls task(begin, end) for each of them, returning when all chunks
+  // are done. Nested calls and calls made while the pool is busy with
+  // another caller run inline. The task must not throw.
+  template <typename Task>
+  void ParallelFor(int count, int grain, Task&& task) {
+    Run(count, grain, &Invoke<std::remove_reference_t<Task>>, &task);
+  }
+
+ private:
+  typedef void (*Function)(void* context, int begin, int end);
+
+  std::atomic<int> size_;
+  std::vector<std::thread> workers_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  bool stop_;
+  unsigned long generation_;
+  Function function_;
+  void* context_;
+  int count_;
+  int chunks_;
+  int next_chunk_;
+  int pending_chunks_;
+
+  ThreadPool(void);
+
+  template <typename Task>
+  static void Invoke(void* context, int begin, int end) {
+    (*static_cast<Task*>(context))(begin, end);
+  }
+
+  void Run(int count, int grain, Function function, void* context);
+  void RunChunks(void);
+  void WorkerLoop(unsigned long seen);
+  void StartWorkers(void);
+  void StopWorkers(void);
+};
+
+}  // namespace s21
+
+#endif  // S21_THREAD_POOL_H_
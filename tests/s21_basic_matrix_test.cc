@@ -0,0 +1,307 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+// Every element type runs the same tests. The elements are small integers,
+// with an imaginary part for complex matrices, so that sums and products are
+// exact in every type; results of divisions are compared with a tolerance
+// that suits the precision of the type.
+
+namespace {
+
+template <typename T>
+class BasicMatrixTest : public testing::Test {};
+
+typedef testing::Types<float, double, long double, std::complex<double>>
+    ElementTypes;
+TYPED_TEST_SUITE(BasicMatrixTest, ElementTypes);
+
+template <typename T>
+T Element(int re, int im) {
+  if constexpr (std::is_same<T, std::complex<double>>::value) {
+    return (T(re, im));
+  } else {
+    (void)im;
+    return (T(re));
+  }
+}
+
+template <typename T>
+double Tolerance(void) {
+  return (std::is_same<T, float>::value ? 1.0e-4 : 1.0e-9);
+}
+
+template <typename T>
+S21BasicMatrix<T> MakeMatrix(int rows, int cols, int seed) {
+  S21BasicMatrix<T> m(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      m(i, j) = Element<T>((i * 7 + j * 3 + seed) % 5 - 2 +
+                               (i == j ? cols : 0),
+                           (i + j * 2 + seed) % 3 - 1);
+    }
+  }
+
+  return (m);
+}
+
+template <typename T>
+S21BasicMatrix<T> NaiveProduct(const S21BasicMatrix<T>& a,
+                               const S21BasicMatrix<T>& b) {
+  S21BasicMatrix<T> product(a.rows(), b.cols());
+  for (int i = 0; i < a.rows(); ++i) {
+    for (int j = 0; j < b.cols(); ++j) {
+      T sum = T(0);
+      for (int p = 0; p < a.cols(); ++p) {
+        sum += a(i, p) * b(p, j);
+      }
+      product(i, j) = sum;
+    }
+  }
+
+  return (product);
+}
+
+template <typename M, typename = void>
+struct CanSave : std::false_type {};
+
+template <typename M>
+struct CanSave<M, decltype(std::declval<const M&>().Save(std::string()))>
+    : std::true_type {};
+
+template <typename M, typename = void>
+struct CanView : std::false_type {};
+
+template <typename M>
+struct CanView<M, std::void_t<decltype(std::declval<M&>().View())>>
+    : std::true_type {};
+
+// Views and the file format are double only; the other types reject them
+// at compile time.
+static_assert(CanSave<S21Matrix>::value && CanView<S21Matrix>::value);
+static_assert(!CanSave<S21FloatMatrix>::value &&
+              !CanView<S21FloatMatrix>::value);
+static_assert(!CanSave<S21LongDoubleMatrix>::value &&
+              !CanView<S21LongDoubleMatrix>::value);
+static_assert(!CanSave<S21ComplexMatrix>::value &&
+              !CanView<S21ComplexMatrix>::value);
+
+template <typename T>
+void ExpectNear(const S21BasicMatrix<T>& actual,
+                const S21BasicMatrix<T>& expected) {
+  ASSERT_EQ(actual.rows(), expected.rows());
+  ASSERT_EQ(actual.cols(), expected.cols());
+  for (int i = 0; i < actual.rows(); ++i) {
+    for (int j = 0; j < actual.cols(); ++j) {
+      EXPECT_LE(std::abs(actual(i, j) - expected(i, j)), Tolerance<T>())
+          << i << ", " << j;
+    }
+  }
+}
+
+}  // namespace
+
+TYPED_TEST(BasicMatrixTest, ElementWise) {
+  typedef TypeParam T;
+  for (int n : {3, 17, 40}) {
+    S21BasicMatrix<T> a = MakeMatrix<T>(n, n + 1, 0);
+    S21BasicMatrix<T> b = MakeMatrix<T>(n, n + 1, 1);
+    S21BasicMatrix<T> sum(a);
+    sum.SumMatrix(b);
+    S21BasicMatrix<T> difference(a);
+    difference.SubMatrix(b);
+    S21BasicMatrix<T> scaled(a);
+    scaled.MulMatrix(Element<T>(3, 1));
+    S21BasicMatrix<T> expression = a + b - a * Element<T>(3, 1);
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j <= n; ++j) {
+        EXPECT_EQ(sum(i, j), a(i, j) + b(i, j));
+        EXPECT_EQ(difference(i, j), a(i, j) - b(i, j));
+        EXPECT_EQ(scaled(i, j), a(i, j) * Element<T>(3, 1));
+        EXPECT_EQ(expression(i, j), sum(i, j) - scaled(i, j));
+      }
+    }
+  }
+  EXPECT_THROW(MakeMatrix<T>(2, 3, 0).SumMatrix(MakeMatrix<T>(3, 2, 0)),
+               std::invalid_argument);
+}
+
+// From magnitude 16 on neighbouring floats are more than 1e-6 apart, so the
+// tolerance of a float matrix grows with the magnitude of its elements. The
+// 21 elements span 16.5 to 1.7e7 and cover the vector loops and their tails.
+TEST(FloatMatrix, EqMatrixAboveUnitMagnitude) {
+  S21FloatMatrix a(3, 7);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 7; ++j) {
+      a(i, j) = std::ldexp(16.5f, i * 7 + j);
+    }
+  }
+  S21FloatMatrix b(a);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 7; ++j) {
+      b(i, j) = std::nextafter(b(i, j), 1.0e9f);
+      ASSERT_GT(b(i, j) - a(i, j), 1.0e-6f);
+    }
+  }
+  EXPECT_GT(S21FloatMatrix::kEps, S21Matrix::kEps);
+  EXPECT_TRUE(a == b);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 7; ++j) {
+      S21FloatMatrix c(a);
+      c(i, j) *= 1.001f;
+      EXPECT_FALSE(a.EqMatrix(c)) << a(i, j);
+      c(i, j) = -a(i, j);
+      EXPECT_FALSE(a.EqMatrix(c)) << a(i, j);
+    }
+  }
+
+  S21FloatMatrix x(1, 1), y(1, 1);
+  x(0, 0) = 3000.0f;
+  y(0, 0) = std::nextafter(3000.0f, 4000.0f);
+  EXPECT_TRUE(x == y);
+  y(0, 0) = INFINITY;
+  EXPECT_FALSE(x == y);
+}
+
+TYPED_TEST(BasicMatrixTest, EqMatrix) {
+  typedef TypeParam T;
+  S21BasicMatrix<T> a = MakeMatrix<T>(5, 4, 0);
+  S21BasicMatrix<T> b(a);
+  EXPECT_TRUE(a == b);
+  b(4, 3) += Element<T>(0, 1);
+  b(4, 3) += Element<T>(1, 0);
+  EXPECT_FALSE(a.EqMatrix(b));
+  EXPECT_FALSE(a == MakeMatrix<T>(4, 5, 0));
+}
+
+// 40 x 40 x 40 and the odd shapes are above the size where the product
+// switches from the naive loop to the packed kernel.
+TYPED_TEST(BasicMatrixTest, Product) {
+  typedef TypeParam T;
+  const int shapes[][3] = {{3, 4, 2}, {40, 40, 40}, {37, 45, 41}, {9, 70, 66}};
+  for (const auto& shape : shapes) {
+    S21BasicMatrix<T> a = MakeMatrix<T>(shape[0], shape[1], 0);
+    S21BasicMatrix<T> b = MakeMatrix<T>(shape[1], shape[2], 2);
+    S21BasicMatrix<T> expected = NaiveProduct(a, b);
+    EXPECT_TRUE(a * b == expected);
+    a.MulMatrix(b, S21BasicMatrix<T>::Multiplication::kStrassen);
+    EXPECT_TRUE(a == expected);
+  }
+  EXPECT_THROW(MakeMatrix<T>(2, 3, 0) * MakeMatrix<T>(2, 3, 0),
+               std::invalid_argument);
+}
+
+TYPED_TEST(BasicMatrixTest, Transpose) {
+  typedef TypeParam T;
+  S21BasicMatrix<T> a = MakeMatrix<T>(19, 6, 0);
+  S21BasicMatrix<T> transposed = a.Transpose();
+  ASSERT_EQ(transposed.rows(), 6);
+  ASSERT_EQ(transposed.cols(), 19);
+  for (int i = 0; i < 19; ++i) {
+    for (int j = 0; j < 6; ++j) {
+      EXPECT_EQ(transposed(j, i), a(i, j));
+    }
+  }
+}
+
+TYPED_TEST(BasicMatrixTest, Determinant) {
+  typedef TypeParam T;
+  S21BasicMatrix<T> a(3, 3);
+  a(0, 0) = T(2);
+  a(0, 1) = T(5);
+  a(0, 2) = T(7);
+  a(1, 0) = T(6);
+  a(1, 1) = T(3);
+  a(1, 2) = T(4);
+  a(2, 0) = T(5);
+  a(2, 1) = T(-2);
+  a(2, 2) = T(-3);
+  EXPECT_EQ(a.Determinant(), T(-1));
+
+  // A unit lower triangular matrix times an upper triangular one has the
+  // product of the diagonal of the latter as its determinant.
+  const int n = 8;
+  S21BasicMatrix<T> lower(n, n);
+  S21BasicMatrix<T> upper(n, n);
+  T expected = T(1);
+  for (int i = 0; i < n; ++i) {
+    lower(i, i) = T(1);
+    upper(i, i) = Element<T>(i % 2 ? -2 : 1, i % 3 == 0);
+    expected *= upper(i, i);
+    for (int j = 0; j < i; ++j) {
+      lower(i, j) = Element<T>((i + j) % 3 - 1, (i * j) % 2);
+      upper(j, i) = Element<T>((i * j) % 5 - 2, 0);
+    }
+  }
+  T det = (lower * upper).Determinant();
+  EXPECT_LE(std::abs(det - expected), Tolerance<T>() * std::abs(expected));
+  EXPECT_THROW(MakeMatrix<T>(2, 3, 0).Determinant(), std::invalid_argument);
+}
+
+TYPED_TEST(BasicMatrixTest, CalcComplements) {
+  typedef TypeParam T;
+  const int values[] = {1, 2, 3, 0, 4, 2, 5, 2, 1};
+  const int complements[] = {0, 10, -20, 4, -14, 8, -8, -2, 4};
+  S21BasicMatrix<T> a(3, 3);
+  for (int k = 0; k < 9; ++k) {
+    a(k / 3, k % 3) = T(values[k]);
+  }
+  S21BasicMatrix<T> result = a.CalcComplements();
+  for (int k = 0; k < 9; ++k) {
+    EXPECT_EQ(result(k / 3, k % 3), T(complements[k]));
+  }
+}
+
+TYPED_TEST(BasicMatrixTest, InverseMatrix) {
+  typedef TypeParam T;
+  for (int n : {2, 4, 30}) {
+    S21BasicMatrix<T> a = MakeMatrix<T>(n, n, 1);
+    S21BasicMatrix<T> identity(n, n);
+    for (int i = 0; i < n; ++i) {
+      identity(i, i) = T(1);
+    }
+    ExpectNear(a * a.InverseMatrix(), identity);
+  }
+  S21BasicMatrix<T> singular(3, 3);
+  singular(0, 0) = T(1);
+  EXPECT_THROW(singular.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(ComplexMatrix, Arithmetic) {
+  typedef std::complex<double> C;
+  S21ComplexMatrix a(2, 2);
+  a(0, 0) = C(1, 1);
+  a(0, 1) = C(0, 1);
+  a(1, 0) = C(2, 0);
+  a(1, 1) = C(1, -1);
+  S21ComplexMatrix square = a * a;
+  EXPECT_EQ(square(0, 0), C(0, 4));
+  EXPECT_EQ(square(0, 1), C(0, 2));
+  EXPECT_EQ(square(1, 0), C(4, 0));
+  EXPECT_EQ(square(1, 1), C(0, 0));
+  EXPECT_EQ(a.Determinant(), C(2, -2));
+  S21ComplexMatrix rotated = a * C(0, 1);
+  EXPECT_EQ(rotated(0, 0), C(-1, 1));
+}
+
+// Small products and the packed kernel expand complex products alike, so an
+// infinite element gives the same result at every size.
+TEST(ComplexMatrix, ProductArithmeticIndependentOfSize) {
+  typedef std::complex<double> C;
+  for (int n : {2, 40}) {
+    S21ComplexMatrix a(n, n), identity(n, n);
+    for (int i = 0; i < n; ++i) {
+      identity(i, i) = C(1, 0);
+    }
+    a(0, 0) = C(INFINITY, INFINITY);
+    S21ComplexMatrix product = a * identity;
+    EXPECT_TRUE(std::isnan(product(0, 0).real())) << n;
+    EXPECT_TRUE(std::isnan(product(0, 0).imag())) << n;
+  }
+}
@@ -0,0 +1,237 @@
+#include "s21_factorization.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "s21_gemm.h"
+#include "s21_test_helpers.h"
+
+namespace {
+
+using s21::test::MakeMatrix;
+
+// A^T A + n I is symmetric positive definite.
+S21Matrix MakeSpd(int n) {
+  S21Matrix a = MakeMatrix(n, n, 0, 0.5);
+  S21Matrix spd = a.Transpose() * a;
+  for (int i = 0; i < n; ++i) {
+    spd(i, i) += n;
+  }
+
+  return (spd);
+}
+
+std::vector<double> Multiply(const S21Matrix& a, const std::vector<double>& x) {
+  std::vector<double> y(a.rows(), 0.0);
+  for (int i = 0; i < a.rows(); ++i) {
+    for (int j = 0; j < a.cols(); ++j) {
+      y[i] += a(i, j) * x[j];
+    }
+  }
+
+  return (y);
+}
+
+std::vector<double> MakeVector(int n) {
+  std::vector<double> v(n);
+  for (int i = 0; i < n; ++i) {
+    v[i] = (i % 5) - 2.0 + 0.25 * i;
+  }
+
+  return (v);
+}
+
+std::vector<double> MakeData(int rows, int cols, double shift) {
+  std::vector<double> data(static_cast<std::size_t>(rows) * cols);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = std::sin(static_cast<double>(i) * 0.37 + shift);
+  }
+
+  return (data);
+}
+
+}  // namespace
+
+TEST(Factorization, LU) {
+  for (int n : {1, 2, 5, 17, 40}) {
+    S21Matrix a = MakeMatrix(n, n, 0, 1.0);
+    S21LU lu(a);
+    std::vector<double> b = MakeVector(n);
+    std::vector<double> x = lu.Solve(b);
+    std::vector<double> ax = Multiply(a, x);
+    for (int i = 0; i < n; ++i) {
+      EXPECT_NEAR(ax[i], b[i], 1.0e-9);
+    }
+
+    S21Matrix rhs = MakeMatrix(n, 3, 0, 2.0);
+    EXPECT_TRUE(a * lu.Solve(rhs) == rhs);
+    EXPECT_TRUE(lu.Inverse() == a.InverseMatrix());
+    EXPECT_NEAR(lu.Determinant(), a.Determinant(),
+                1.0e-9 * (1.0 + fabs(a.Determinant())));
+  }
+}
+
+TEST(Factorization, LUSingular) {
+  S21Matrix a(3, 3);
+  a(0, 0) = 1.0;
+  a(0, 1) = 2.0;
+  a(1, 0) = 2.0;
+  a(1, 1) = 4.0;
+  a(2, 2) = 1.0;
+  S21LU lu(a);
+  EXPECT_TRUE(lu.IsSingular());
+  EXPECT_EQ(lu.Determinant(), 0.0);
+  EXPECT_THROW(lu.Solve(MakeVector(3)), std::invalid_argument);
+  EXPECT_THROW(lu.Inverse(), std::invalid_argument);
+  EXPECT_THROW(S21LU(S21Matrix(2, 3)), std::invalid_argument);
+  EXPECT_THROW(S21LU(MakeMatrix(2, 2, 0, 3.0)).Solve(MakeVector(3)),
+               std::invalid_argument);
+}
+
+// Past S21LU::kBlockedMinSize the LU factorization and all matrix solves are
+// blocked, and S21Matrix::Determinant and InverseMatrix go through S21LU.
+TEST(Factorization, BlockedLU) {
+  int n = S21LU::kBlockedMinSize + S21LU::kBlockSize / 2 + 3;
+  S21Matrix a = MakeMatrix(n, n, 0, 4.0);
+  S21LU lu(a);
+  EXPECT_FALSE(lu.IsSingular());
+
+  const S21Matrix& factors = lu.factors();
+  S21Matrix l(n, n);
+  S21Matrix u(n, n);
+  S21Matrix pa(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      if (j < i) {
+        l(i, j) = factors(i, j);
+      } else {
+        u(i, j) = factors(i, j);
+      }
+      pa(i, j) = a(lu.pivots()[i], j);
+    }
+    l(i, i) = 1.0;
+  }
+  EXPECT_TRUE(l * u == pa);
+
+  S21Matrix rhs = MakeMatrix(n, 5, 0, 1.0);
+  EXPECT_TRUE(a * lu.Solve(rhs) == rhs);
+  S21Matrix spd = MakeSpd(n);
+  EXPECT_TRUE(spd * S21Cholesky(spd).Solve(rhs) == rhs);
+  std::vector<double> b = MakeVector(n);
+  std::vector<double> ax = Multiply(a, lu.Solve(b));
+  for (int i = 0; i < n; ++i) {
+    EXPECT_NEAR(ax[i], b[i], 1.0e-9);
+  }
+
+  S21Matrix identity(n, n);
+  for (int i = 0; i < n; ++i) {
+    identity(i, i) = 1.0;
+  }
+  EXPECT_TRUE(a * a.InverseMatrix() == identity);
+  EXPECT_NEAR(lu.Determinant(), a.Determinant(),
+              1.0e-12 * fabs(lu.Determinant()));
+
+  for (int j = 0; j < n; ++j) {
+    a(n - 1, j) = a(0, j) + a(1, j);
+  }
+  EXPECT_TRUE(S21LU(a).IsSingular());
+  EXPECT_THROW(a.InverseMatrix(), std::invalid_argument);
+}
+
+// The blocked LU subtracts products through a Gemm alpha of -1. Scaling A
+// by -1 rounds the same as adding the product to -C and negating the sum,
+// on the small and on the packed path.
+TEST(Factorization, GemmAlpha) {
+  for (int n : {12, 70}) {
+    std::vector<double> a = MakeData(n, n + 3, 0.5);
+    std::vector<double> b = MakeData(n + 3, n, 1.5);
+    std::vector<double> c = MakeData(n, n, 2.5);
+    std::vector<double> expected(c.size());
+    std::transform(c.begin(), c.end(), expected.begin(),
+                   [](double x) { return (-x); });
+    s21::Gemm(n, n, n + 3, a.data(), n + 3, 1, b.data(), n, 1,
+              expected.data(), n, 1);
+    s21::Gemm(n, n, n + 3, a.data(), n + 3, 1, b.data(), n, 1, c.data(), n,
+              1, -1.0);
+    for (std::size_t i = 0; i < c.size(); ++i) {
+      ASSERT_EQ(c[i], -expected[i]) << n << " " << i;
+    }
+  }
+}
+
+TEST(Factorization, Cholesky) {
+  for (int n : {1, 3, 8, 33}) {
+    S21Matrix a = MakeSpd(n);
+    S21Cholesky cholesky(a);
+    const S21Matrix& l = cholesky.factor();
+    EXPECT_TRUE(l * l.Transpose() == a);
+
+    std::vector<double> b = MakeVector(n);
+    std::vector<double> ax = Multiply(a, cholesky.Solve(b));
+    for (int i = 0; i < n; ++i) {
+      EXPECT_NEAR(ax[i], b[i], 1.0e-9);
+    }
+    S21Matrix rhs = MakeMatrix(n, 4, 0, 0.0);
+    EXPECT_TRUE(a * cholesky.Solve(rhs) == rhs);
+    EXPECT_TRUE(cholesky.Inverse() == a.InverseMatrix());
+    EXPECT_NEAR(cholesky.Determinant(), a.Determinant(),
+                1.0e-9 * fabs(a.Determinant()));
+  }
+
+  S21Matrix indefinite = MakeSpd(4);
+  indefinite(2, 2) = -1.0;
+  EXPECT_THROW(S21Cholesky{indefinite}, std::invalid_argument);
+  EXPECT_THROW(S21Cholesky(S21Matrix(3, 2)), std::invalid_argument);
+}
+
+TEST(Factorization, QR) {
+  for (int n : {1, 4, 9, 30}) {
+    S21Matrix a = MakeMatrix(n, n, 0, -1.5);
+    S21QR qr(a);
+    std::vector<double> b = MakeVector(n);
+    std::vector<double> ax = Multiply(a, qr.Solve(b));
+    for (int i = 0; i < n; ++i) {
+      EXPECT_NEAR(ax[i], b[i], 1.0e-9);
+    }
+    S21Matrix rhs = MakeMatrix(n, 2, 0, 1.0);
+    EXPECT_TRUE(a * qr.Solve(rhs) == rhs);
+    EXPECT_TRUE(qr.Inverse() == a.InverseMatrix());
+    EXPECT_NEAR(qr.Determinant(), a.Determinant(),
+                1.0e-9 * (1.0 + fabs(a.Determinant())));
+  }
+}
+
+// The least-squares solution makes the residual orthogonal to the columns.
+TEST(Factorization, QRLeastSquares) {
+  S21Matrix a = MakeMatrix(12, 4, 0, 2.0);
+  S21QR qr(a);
+  std::vector<double> b = MakeVector(12);
+  std::vector<double> x = qr.Solve(b);
+  ASSERT_EQ(x.size(), 4u);
+
+  std::vector<double> residual = Multiply(a, x);
+  for (int i = 0; i < 12; ++i) {
+    residual[i] -= b[i];
+  }
+  std::vector<double> normal = Multiply(a.Transpose(), residual);
+  for (double value : normal) {
+    EXPECT_NEAR(value, 0.0, 1.0e-9);
+  }
+
+  S21Matrix rhs(12, 1);
+  for (int i = 0; i < 12; ++i) {
+    rhs(i, 0) = b[i];
+  }
+  S21Matrix solution = qr.Solve(rhs);
+  for (int j = 0; j < 4; ++j) {
+    EXPECT_NEAR(solution(j, 0), x[j], 1.0e-12);
+  }
+
+  EXPECT_THROW(qr.Determinant(), std::invalid_argument);
+  EXPECT_THROW(qr.Inverse(), std::invalid_argument);
+  EXPECT_THROW(S21QR(S21Matrix(2, 3)), std::invalid_argument);
+  EXPECT_TRUE(S21QR(S21Matrix(3, 3)).IsRankDeficient());
+}
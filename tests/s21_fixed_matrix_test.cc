@@ -0,0 +1,163 @@
+#include "s21_fixed_matrix.h"
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+template <typename A, typename B, typename = void>
+struct CanAdd : std::false_type {};
+
+template <typename A, typename B>
+struct CanAdd<A, B,
+              std::void_t<decltype(std::declval<A>() + std::declval<B>())>>
+    : std::true_type {};
+
+template <typename A, typename B, typename = void>
+struct CanMultiply : std::false_type {};
+
+template <typename A, typename B>
+struct CanMultiply<A, B,
+                   std::void_t<decltype(std::declval<A>() *
+                                        std::declval<B>())>>
+    : std::true_type {};
+
+template <int R, int C>
+S21FixedMatrix<R, C> MakeFixed(double shift) {
+  S21FixedMatrix<R, C> matrix;
+  for (int i = 0; i < R; ++i) {
+    for (int j = 0; j < C; ++j) {
+      matrix(i, j) = ((i * 7 + j * 3) % 11) - 5.0 + shift;
+    }
+  }
+
+  return (matrix);
+}
+
+constexpr S21Matrix3 MakeConstexpr(void) {
+  S21Matrix3 matrix;
+  matrix(0, 0) = 2.0;
+  matrix(0, 1) = 5.0;
+  matrix(0, 2) = 7.0;
+  matrix(1, 0) = 6.0;
+  matrix(1, 1) = 3.0;
+  matrix(1, 2) = 4.0;
+  matrix(2, 0) = 5.0;
+  matrix(2, 1) = -2.0;
+  matrix(2, 2) = -3.0;
+
+  return (matrix);
+}
+
+}  // namespace
+
+TEST(FixedMatrix, CompileTimeDimensions) {
+  static_assert(S21FixedMatrix<2, 3>::rows() == 2);
+  static_assert(S21FixedMatrix<2, 3>::cols() == 3);
+  static_assert(sizeof(S21FixedMatrix<4, 4>) == 16 * sizeof(double));
+  static_assert(CanAdd<S21Matrix3, S21Matrix3>::value);
+  static_assert(!CanAdd<S21Matrix3, S21FixedMatrix<3, 2>>::value);
+  static_assert(CanMultiply<S21FixedMatrix<2, 3>, S21FixedMatrix<3, 4>>::value);
+  static_assert(
+      !CanMultiply<S21FixedMatrix<2, 3>, S21FixedMatrix<2, 3>>::value);
+  static_assert(std::is_same_v<decltype(S21FixedMatrix<2, 3>() *
+                                        S21FixedMatrix<3, 4>()),
+                               S21FixedMatrix<2, 4>>);
+}
+
+TEST(FixedMatrix, ConstexprEvaluation) {
+  constexpr S21Matrix3 matrix = MakeConstexpr();
+  constexpr double det = matrix.Determinant();
+  static_assert(det == -1.0);
+  constexpr S21Matrix3 square = matrix * matrix;
+  static_assert(square(0, 0) == 69.0);
+  static_assert(matrix.Transpose()(0, 1) == 6.0);
+  static_assert(matrix == MakeConstexpr());
+  static_assert(!matrix.EqMatrix(square));
+  static_assert(matrix.EqMatrix(matrix + matrix * 1.0e-7));
+  EXPECT_DOUBLE_EQ(det, -1.0);
+}
+
+TEST(FixedMatrix, MatchesDynamicMatrix) {
+  S21FixedMatrix<3, 4> a = MakeFixed<3, 4>(0.5);
+  S21FixedMatrix<3, 4> b = MakeFixed<3, 4>(-1.25);
+  S21FixedMatrix<4, 2> c = MakeFixed<4, 2>(2.0);
+  S21Matrix da(a), db(b), dc(c);
+
+  EXPECT_TRUE(S21Matrix(a + b) == da + db);
+  EXPECT_TRUE(S21Matrix(a - b) == da - db);
+  EXPECT_TRUE(S21Matrix(a * 2.5) == da * 2.5);
+  EXPECT_TRUE(S21Matrix(2.5 * a) == da * 2.5);
+  EXPECT_TRUE(S21Matrix(a * c) == da * dc);
+  EXPECT_TRUE(S21Matrix(a.Transpose()) == da.Transpose());
+}
+
+TEST(FixedMatrix, CompoundAssignment) {
+  S21Matrix4 a = MakeFixed<4, 4>(0.0);
+  S21Matrix4 b = MakeFixed<4, 4>(1.0);
+  S21Matrix4 expected = a * b;
+  a *= b;
+  EXPECT_TRUE(a == expected);
+  a += b;
+  a -= b;
+  EXPECT_TRUE(a == expected);
+  a *= 0.5;
+  EXPECT_TRUE(a == expected * 0.5);
+}
+
+TEST(FixedMatrix, Determinant) {
+  S21Matrix4 m4 = MakeFixed<4, 4>(0.25);
+  S21FixedMatrix<6, 6> m6 = MakeFixed<6, 6>(0.25);
+  m6(2, 2) = 9.0;
+  EXPECT_NEAR(m4.Determinant(), S21Matrix(m4).Determinant(), 1e-9);
+  EXPECT_NEAR(m6.Determinant(), S21Matrix(m6).Determinant(), 1e-6);
+  S21FixedMatrix<1, 1> m1;
+  m1(0, 0) = -3.5;
+  EXPECT_DOUBLE_EQ(m1.Determinant(), -3.5);
+}
+
+TEST(FixedMatrix, CalcComplements) {
+  S21Matrix4 matrix = MakeFixed<4, 4>(0.75);
+  EXPECT_TRUE(S21Matrix(matrix.CalcComplements()) ==
+              S21Matrix(matrix).CalcComplements());
+}
+
+TEST(FixedMatrix, InverseMatrix) {
+  S21Matrix4 m4 = MakeFixed<4, 4>(0.25);
+  S21FixedMatrix<6, 6> m6 = MakeFixed<6, 6>(0.25);
+  m6(2, 2) = 9.0;
+  S21Matrix identity4(4, 4), identity6(6, 6);
+  for (int i = 0; i < 6; ++i) {
+    identity6(i, i) = 1.0;
+    if (i < 4) {
+      identity4(i, i) = 1.0;
+    }
+  }
+
+  EXPECT_TRUE(S21Matrix(m4 * m4.InverseMatrix()) == identity4);
+  EXPECT_TRUE(S21Matrix(m6 * m6.InverseMatrix()) == identity6);
+  EXPECT_TRUE(S21Matrix(m6.InverseMatrix()) == S21Matrix(m6).InverseMatrix());
+}
+
+TEST(FixedMatrix, SingularInverse) {
+  S21Matrix3 m3;
+  m3(0, 0) = 1.0;
+  m3(1, 1) = 1.0;
+  S21FixedMatrix<5, 5> m5 = MakeFixed<5, 5>(0.0);
+  for (int j = 0; j < 5; ++j) {
+    m5(4, j) = m5(0, j) * 2.0;
+  }
+  EXPECT_THROW(m3.InverseMatrix(), std::invalid_argument);
+  EXPECT_THROW(m5.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(FixedMatrix, Conversion) {
+  S21Matrix dynamic(2, 3);
+  dynamic(1, 2) = 4.5;
+  S21FixedMatrix<2, 3> fixed(dynamic);
+  EXPECT_DOUBLE_EQ(fixed(1, 2), 4.5);
+  EXPECT_TRUE(S21Matrix(fixed) == dynamic);
+  EXPECT_THROW((S21FixedMatrix<3, 2>(dynamic)), std::invalid_argument);
+}
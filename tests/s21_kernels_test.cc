@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "s21_kernels.h"
+
+namespace {
+
+const s21::SimdLevel kLevels[] = {s21::SimdLevel::kScalar,
+                                  s21::SimdLevel::kSse2, s21::SimdLevel::kAvx2,
+                                  s21::SimdLevel::kAvx512};
+
+template <typename T = double>
+std::vector<T> MakeData(std::size_t n, double shift) {
+  std::vector<T> data(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    data[i] = static_cast<T>(static_cast<double>(i % 37) * 0.75 - 13.0 + shift);
+  }
+
+  return (data);
+}
+
+class KernelsTest : public testing::TestWithParam<s21::SimdLevel> {
+ protected:
+  void SetUp(void) override {
+    if (s21::SetSimdLevel(GetParam()) != GetParam()) {
+      GTEST_SKIP() << "The instruction set is not supported by this host.";
+    }
+  }
+
+  void TearDown(void) override { s21::SetSimdLevel(s21::DetectSimdLevel()); }
+};
+
+}  // namespace
+
+TEST(MatrixKernels, DetectedLevelIsActive) {
+  EXPECT_EQ(s21::ActiveSimdLevel(), s21::DetectSimdLevel());
+}
+
+TEST_P(KernelsTest, Add) {
+  for (std::size_t n = 0; n < 40; ++n) {
+    std::vector<double> dst = MakeData(n, 0.5);
+    std::vector<double> src = MakeData(n, 2.25);
+    s21::AddKernel(dst.data(), src.data(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(dst[i], MakeData(n, 0.5)[i] + src[i]);
+    }
+  }
+}
+
+TEST_P(KernelsTest, Sub) {
+  for (std::size_t n = 0; n < 40; ++n) {
+    std::vector<double> dst = MakeData(n, 0.5);
+    std::vector<double> src = MakeData(n, 2.25);
+    s21::SubKernel(dst.data(), src.data(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(dst[i], MakeData(n, 0.5)[i] - src[i]);
+    }
+  }
+}
+
+TEST_P(KernelsTest, Scale) {
+  for (std::size_t n = 0; n < 40; ++n) {
+    std::vector<double> dst = MakeData(n, 0.5);
+    s21::ScaleKernel(dst.data(), -3.5, n);
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(dst[i], MakeData(n, 0.5)[i] * -3.5);
+    }
+  }
+}
+
+TEST_P(KernelsTest, Axpy) {
+  for (std::size_t n = 0; n < 40; ++n) {
+    std::vector<double> dst = MakeData(n, 0.5);
+    std::vector<double> src = MakeData(n, 2.25);
+    s21::AxpyKernel(dst.data(), 1.75, src.data(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(dst[i], MakeData(n, 0.5)[i] + 1.75 * src[i]);
+    }
+  }
+}
+
+TEST_P(KernelsTest, Equal) {
+  for (std::size_t n = 1; n < 40; ++n) {
+    std::vector<double> a = MakeData(n, 0.0);
+    std::vector<double> b = a;
+    EXPECT_TRUE(s21::EqualKernel(a.data(), b.data(), n, 1.0e-6));
+    for (std::size_t i = 0; i < n; ++i) {
+      b[i] += 0.5e-6;
+      EXPECT_TRUE(s21::EqualKernel(a.data(), b.data(), n, 1.0e-6));
+      b[i] -= 2.0e-6;
+      EXPECT_FALSE(s21::EqualKernel(a.data(), b.data(), n, 1.0e-6));
+      b[i] = a[i];
+    }
+  }
+}
+
+// Long enough for a full AVX-512 float vector and every tail length.
+TEST_P(KernelsTest, FloatArithmetic) {
+  for (std::size_t n = 0; n < 40; ++n) {
+    std::vector<float> a = MakeData<float>(n, 0.5);
+    std::vector<float> b = MakeData<float>(n, 2.25);
+    std::vector<float> sum = a;
+    std::vector<float> difference = a;
+    std::vector<float> scaled = a;
+    std::vector<float> axpy = a;
+    s21::AddKernel(sum.data(), b.data(), n);
+    s21::SubKernel(difference.data(), b.data(), n);
+    s21::ScaleKernel(scaled.data(), -3.5f, n);
+    s21::AxpyKernel(axpy.data(), 1.75f, b.data(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(sum[i], a[i] + b[i]);
+      EXPECT_EQ(difference[i], a[i] - b[i]);
+      EXPECT_EQ(scaled[i], a[i] * -3.5f);
+      EXPECT_EQ(axpy[i], a[i] + 1.75f * b[i]);
+    }
+  }
+}
+
+TEST_P(KernelsTest, FloatEqual) {
+  for (std::size_t n = 1; n < 40; ++n) {
+    std::vector<float> a = MakeData<float>(n, 0.0);
+    std::vector<float> b = a;
+    EXPECT_TRUE(s21::EqualKernel(a.data(), b.data(), n, 1.0e-3));
+    for (std::size_t i = 0; i < n; ++i) {
+      b[i] += 0.5e-3f;
+      EXPECT_TRUE(s21::EqualKernel(a.data(), b.data(), n, 1.0e-3));
+      b[i] -= 2.0e-3f;
+      EXPECT_FALSE(s21::EqualKernel(a.data(), b.data(), n, 1.0e-3));
+      b[i] = a[i];
+    }
+  }
+}
+
+// The relative part scales with the smaller magnitude, so an infinity never
+// matches a finite value however large the fraction.
+TEST_P(KernelsTest, RelativeEqual) {
+  for (std::size_t n = 1; n < 40; ++n) {
+    std::vector<double> a = MakeData(n, 1.0e6);
+    std::vector<float> c = MakeData<float>(n, 1.0e6);
+    std::vector<double> b = a;
+    std::vector<float> d = c;
+    for (std::size_t i = 0; i < n; ++i) {
+      b[i] *= 1.0 + 0.5e-3;
+      d[i] *= 1.0f + 0.5e-3f;
+      EXPECT_FALSE(s21::EqualKernel(a.data(), b.data(), n, 1.0e-6));
+      EXPECT_TRUE(s21::EqualKernel(a.data(), b.data(), n, 1.0e-6, 1.0e-3));
+      EXPECT_TRUE(s21::EqualKernel(c.data(), d.data(), n, 1.0e-6, 1.0e-3));
+      b[i] = a[i] * (1.0 + 2.0e-3);
+      d[i] = c[i] * (1.0f + 2.0e-3f);
+      EXPECT_FALSE(s21::EqualKernel(a.data(), b.data(), n, 1.0e-6, 1.0e-3));
+      EXPECT_FALSE(s21::EqualKernel(c.data(), d.data(), n, 1.0e-6, 1.0e-3));
+      b[i] = INFINITY;
+      d[i] = INFINITY;
+      EXPECT_FALSE(s21::EqualKernel(a.data(), b.data(), n, 1.0e-6, 1.0e-3));
+      EXPECT_FALSE(s21::EqualKernel(c.data(), d.data(), n, 1.0e-6, 1.0e-3));
+      b[i] = a[i];
+      d[i] = c[i];
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(MatrixKernels, KernelsTest,
+                         testing::ValuesIn(kLevels));
@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_oop.h"
+#include "s21_test_helpers.h"
+
+// The matrices under test come from a counting allocator, so the tests can
+// check how many allocations an expression makes; the system allocator
+// counts what reached operator new.
+
+namespace {
+
+using s21::test::CountingAllocator;
+
+// Large enough to live on the heap rather than in the inline buffer.
+const int kRows = 24;
+const int kCols = 40;
+
+S21Matrix MakeMatrix(double shift) {
+  S21Matrix m(kRows, kCols);
+  for (int i = 0; i < kRows; ++i) {
+    for (int j = 0; j < kCols; ++j) {
+      m(i, j) = i * 0.5 - j + shift;
+    }
+  }
+
+  return (m);
+}
+
+std::size_t SystemAllocations(void) {
+  return (S21MatrixAllocator::System().stats().system_allocations);
+}
+
+// Serves allocations from a fixed buffer, to check that S21Matrix goes
+// through whatever allocator is current.
+class BufferAllocator : public S21MatrixAllocator {
+ public:
+  void* Allocate(std::size_t bytes) override {
+    if (used_ + bytes > sizeof(buffer_)) {
+      throw std::bad_alloc();
+    }
+    void* ptr = buffer_ + used_;
+    used_ += (bytes + kAlignment - 1) / kAlignment * kAlignment;
+    CountAllocation(bytes);
+
+    return (ptr);
+  }
+
+  void Deallocate(void*, std::size_t bytes) noexcept override {
+    CountDeallocation(bytes);
+  }
+
+ private:
+  alignas(64) char buffer_[1 << 14];
+  std::size_t used_ = 0;
+};
+
+}  // namespace
+
+TEST(MatrixAllocations, MovedLeftOperand) {
+  CountingAllocator counter;
+  S21MatrixAllocatorScope scope(counter);
+  S21Matrix a = MakeMatrix(1.0), b = MakeMatrix(2.0);
+  S21Matrix sum = a + b, difference = a - b;
+
+  S21Matrix a1(a), a2(a);
+  std::size_t before = counter.allocations();
+  S21Matrix r1 = std::move(a1) + b;
+  S21Matrix r2 = std::move(a2) - b;
+  EXPECT_EQ(counter.allocations() - before, 0u);
+  EXPECT_TRUE(r1 == sum);
+  EXPECT_TRUE(r2 == difference);
+}
+
+TEST(MatrixAllocations, MovedRightOperand) {
+  CountingAllocator counter;
+  S21MatrixAllocatorScope scope(counter);
+  S21Matrix a = MakeMatrix(1.0), b = MakeMatrix(2.0);
+  S21Matrix sum = a + b, difference = a - b;
+
+  S21Matrix b1(b), b2(b);
+  std::size_t before = counter.allocations();
+  S21Matrix r1 = a + std::move(b1);
+  S21Matrix r2 = a - std::move(b2);
+  EXPECT_EQ(counter.allocations() - before, 0u);
+  EXPECT_TRUE(r1 == sum);
+  EXPECT_TRUE(r2 == difference);
+}
+
+TEST(MatrixAllocations, TemporaryOperands) {
+  CountingAllocator counter;
+  S21MatrixAllocatorScope scope(counter);
+  S21Matrix a = MakeMatrix(1.0), b = MakeMatrix(2.0);
+  S21Matrix expected = (a * 3.0 + b) * 0.5 - a;
+
+  std::size_t before = counter.allocations();
+  S21Matrix r1 = MakeMatrix(1.0) * 3.0;
+  S21Matrix r2 = 0.5 * (std::move(r1) + MakeMatrix(2.0)) - a;
+  EXPECT_EQ(counter.allocations() - before, 2u);
+  EXPECT_TRUE(r2 == expected);
+}
+
+TEST(MatrixAllocations, ProductAllocatesResultOnly) {
+  CountingAllocator counter;
+  S21MatrixAllocatorScope scope(counter);
+  S21Matrix a = MakeMatrix(1.0), b(kCols, kRows);
+  b(3, 5) = 1.0;
+
+  std::size_t before = counter.allocations();
+  S21Matrix product = std::move(a) * b;
+  EXPECT_EQ(counter.allocations() - before, 1u);
+  EXPECT_EQ(product.rows(), kRows);
+  EXPECT_EQ(product.cols(), kRows);
+}
+
+TEST(MatrixAllocations, ExpressionAllocatesResultOnly) {
+  CountingAllocator counter;
+  S21MatrixAllocatorScope scope(counter);
+  S21Matrix a = MakeMatrix(1.0), b = MakeMatrix(2.0), c = MakeMatrix(3.0);
+
+  std::size_t before = counter.allocations();
+  S21Matrix result = a + b - c * 2.0;
+  EXPECT_EQ(counter.allocations() - before, 1u);
+  EXPECT_EQ(result(0, 0), 1.0 + 2.0 - 3.0 * 2.0);
+}
+
+TEST(MatrixAllocations, CustomAllocator) {
+  BufferAllocator allocator;
+  S21Matrix outside = MakeMatrix(0.0);
+  {
+    S21MatrixAllocatorScope scope(allocator);
+    EXPECT_EQ(&S21MatrixAllocator::Current(), &allocator);
+    std::size_t before = SystemAllocations();
+    S21Matrix a = MakeMatrix(1.0);
+    S21Matrix small(2, 2);
+    S21Matrix sum = a + outside;
+    EXPECT_EQ(SystemAllocations() - before, 0u);
+    EXPECT_EQ(sum(1, 2), outside(1, 2) + a(1, 2));
+    EXPECT_EQ(allocator.stats().allocations, 2u);
+    EXPECT_EQ(allocator.stats().bytes_in_use, 2 * kRows * kCols * 8u);
+  }
+  EXPECT_EQ(&S21MatrixAllocator::Current(), &S21MatrixAllocator::System());
+  EXPECT_EQ(allocator.stats().deallocations, 2u);
+  EXPECT_EQ(allocator.stats().bytes_in_use, 0u);
+}
+
+TEST(MatrixAllocations, PoolReusesBlocks) {
+  S21MatrixAllocator& pool = S21MatrixAllocator::Pool();
+  S21MatrixAllocatorScope scope(pool);
+  S21Matrix a = MakeMatrix(1.0), b = MakeMatrix(2.0);
+  S21Matrix expected = a + b;
+  // The first rounds fill the free lists of this thread.
+  for (int i = 0; i < 2; ++i) {
+    S21Matrix sum = a + b;
+    S21Matrix transposed = sum.Transpose();
+    EXPECT_TRUE(transposed.Transpose() == expected);
+  }
+  pool.ResetStats();
+
+  std::size_t before = SystemAllocations();
+  for (int i = 0; i < 100; ++i) {
+    S21Matrix sum = a + b;
+    S21Matrix transposed = sum.Transpose();
+    EXPECT_TRUE(transposed.Transpose() == expected);
+  }
+  EXPECT_EQ(SystemAllocations() - before, 0u);
+  S21MatrixAllocatorStats stats = pool.stats();
+  EXPECT_EQ(stats.allocations, 300u);
+  EXPECT_EQ(stats.deallocations, 300u);
+  EXPECT_EQ(stats.system_allocations, 0u);
+  EXPECT_EQ(stats.peak_bytes_in_use - stats.bytes_in_use,
+            3 * kRows * kCols * 8u);
+}
+
+// A matrix returns its storage to the allocator it came from, even when
+// another one is current by the time it is destroyed.
+TEST(MatrixAllocations, PooledMatrixOutlivesScope) {
+  S21MatrixAllocator& pool = S21MatrixAllocator::Pool();
+  S21Matrix m;
+  std::size_t deallocations = pool.stats().deallocations;
+  {
+    S21MatrixAllocatorScope scope(pool);
+    m = MakeMatrix(3.0);
+  }
+  m.set_rows(kRows + 1);
+  EXPECT_EQ(pool.stats().deallocations, deallocations + 1);
+  EXPECT_EQ(m(0, 0), 3.0);
+}
+
+TEST(MatrixAllocations, Arena) {
+  S21MatrixArena arena(1 << 16);
+  S21MatrixAllocatorScope scope(arena);
+  S21Matrix a = MakeMatrix(1.0), b = MakeMatrix(2.0);
+  S21Matrix expected = (a + b) * 2.0;
+
+  std::size_t before = SystemAllocations();
+  for (int i = 0; i < 100; ++i) {
+    S21Matrix sum = a + b;
+    sum *= 2.0;
+    EXPECT_TRUE(sum == expected);
+  }
+  EXPECT_EQ(SystemAllocations() - before, 0u);
+  S21MatrixAllocatorStats stats = arena.stats();
+  EXPECT_EQ(stats.system_allocations, 1u);
+  EXPECT_EQ(stats.bytes_reserved, std::size_t(1) << 16);
+  EXPECT_EQ(stats.allocations, 103u);
+
+  // Larger than a block, and after the last matrix is gone the arena starts
+  // over from its first block.
+  S21Matrix large(300, 300);
+  EXPECT_EQ(arena.stats().system_allocations, 2u);
+  a = S21Matrix(1, 1);
+  b = S21Matrix(1, 1);
+  expected = S21Matrix(1, 1);
+  large = S21Matrix(1, 1);
+  EXPECT_EQ(arena.stats().bytes_in_use, 0u);
+  S21Matrix again = MakeMatrix(4.0);
+  EXPECT_EQ(arena.stats().system_allocations, 2u);
+}
@@ -0,0 +1,136 @@
+#include "s21_matrix_batch.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include "s21_kernels.h"
+#include "s21_test_helpers.h"
+
+namespace {
+
+const int kCount = 13;
+
+// Diagonally dominant enough for the batch inverses.
+S21Matrix MakeMatrix(int rows, int cols, int seed) {
+  return (s21::test::MakeMatrix(rows, cols, seed, seed % 3 + 2.0));
+}
+
+S21MatrixBatch MakeBatch(int rows, int cols, int seed,
+                         S21MatrixBatch::Layout layout) {
+  S21MatrixBatch batch(kCount, rows, cols, layout);
+  for (int b = 0; b < kCount; ++b) {
+    batch.Set(b, MakeMatrix(rows, cols, seed + b));
+  }
+
+  return (batch);
+}
+
+class MatrixBatchTest
+    : public testing::TestWithParam<
+          std::tuple<S21MatrixBatch::Layout, s21::SimdLevel>> {
+ protected:
+  void SetUp(void) override {
+    layout_ = std::get<0>(GetParam());
+    if (s21::SetSimdLevel(std::get<1>(GetParam())) !=
+        std::get<1>(GetParam())) {
+      GTEST_SKIP() << "The instruction set is not supported by this host.";
+    }
+  }
+
+  void TearDown(void) override { s21::SetSimdLevel(s21::DetectSimdLevel()); }
+
+  S21MatrixBatch::Layout layout_;
+};
+
+}  // namespace
+
+TEST_P(MatrixBatchTest, LayoutRoundTrip) {
+  S21MatrixBatch batch = MakeBatch(3, 4, 0, layout_);
+  S21MatrixBatch other = batch.ToLayout(S21MatrixBatch::Layout::kAos)
+                             .ToLayout(S21MatrixBatch::Layout::kSoa);
+  EXPECT_EQ(batch.layout(), layout_);
+  EXPECT_TRUE(batch == other);
+  for (int b = 0; b < kCount; ++b) {
+    EXPECT_TRUE(other.Get(b) == MakeMatrix(3, 4, b));
+    EXPECT_EQ(batch(b, 2, 1), MakeMatrix(3, 4, b)(2, 1));
+  }
+}
+
+TEST_P(MatrixBatchTest, SumAndProduct) {
+  S21MatrixBatch a = MakeBatch(3, 5, 1, layout_);
+  S21MatrixBatch b = MakeBatch(3, 5, 4, S21MatrixBatch::Layout::kSoa);
+  S21MatrixBatch c = MakeBatch(5, 2, 7, S21MatrixBatch::Layout::kAos);
+
+  S21MatrixBatch sum = a + b;
+  S21MatrixBatch product = a * c;
+  EXPECT_EQ(product.rows(), 3);
+  EXPECT_EQ(product.cols(), 2);
+  EXPECT_EQ(product.layout(), layout_);
+  for (int i = 0; i < kCount; ++i) {
+    EXPECT_TRUE(sum.Get(i) == a.Get(i) + b.Get(i));
+    EXPECT_TRUE(product.Get(i) == a.Get(i) * c.Get(i));
+  }
+
+  EXPECT_THROW(a * b, std::invalid_argument);
+  EXPECT_THROW(a + c, std::invalid_argument);
+}
+
+TEST_P(MatrixBatchTest, Transpose) {
+  S21MatrixBatch batch = MakeBatch(4, 3, 2, layout_);
+  S21MatrixBatch transposed = batch.Transpose();
+  EXPECT_EQ(transposed.rows(), 3);
+  EXPECT_EQ(transposed.cols(), 4);
+  for (int b = 0; b < kCount; ++b) {
+    EXPECT_TRUE(transposed.Get(b) == batch.Get(b).Transpose());
+  }
+}
+
+TEST_P(MatrixBatchTest, DeterminantAndInverse) {
+  for (int n = 1; n <= 6; ++n) {
+    S21MatrixBatch batch = MakeBatch(n, n, n, layout_);
+    std::vector<double> det = batch.Determinant();
+    S21MatrixBatch inverse = batch.InverseMatrix();
+    ASSERT_EQ(det.size(), static_cast<std::size_t>(kCount));
+    for (int b = 0; b < kCount; ++b) {
+      S21Matrix m = batch.Get(b);
+      EXPECT_NEAR(det[b], m.Determinant(), 1.0e-9 * (1.0 + fabs(det[b])));
+      EXPECT_TRUE(inverse.Get(b) == m.InverseMatrix());
+    }
+  }
+}
+
+TEST_P(MatrixBatchTest, Singular) {
+  S21MatrixBatch batch = MakeBatch(3, 3, 0, layout_);
+  S21Matrix singular(3, 3);
+  singular(0, 0) = 1.0;
+  singular(1, 1) = 2.0;
+  batch.Set(kCount - 1, singular);
+
+  EXPECT_EQ(batch.Determinant()[kCount - 1], 0.0);
+  EXPECT_THROW(batch.InverseMatrix(), std::invalid_argument);
+  EXPECT_THROW(S21MatrixBatch(2, 2, 3).Determinant(), std::invalid_argument);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    MatrixBatch, MatrixBatchTest,
+    testing::Combine(testing::Values(S21MatrixBatch::Layout::kAos,
+                                     S21MatrixBatch::Layout::kSoa),
+                     testing::Values(s21::SimdLevel::kScalar,
+                                     s21::SimdLevel::kAvx2,
+                                     s21::SimdLevel::kAvx512)));
+
+TEST(MatrixBatch, InvalidArguments) {
+  EXPECT_THROW(S21MatrixBatch(0, 2, 2), std::invalid_argument);
+  EXPECT_THROW(S21MatrixBatch(2, 0, 2), std::invalid_argument);
+  EXPECT_THROW(S21MatrixBatch(2, 2, 0), std::invalid_argument);
+
+  S21MatrixBatch batch(3, 2, 2);
+  EXPECT_THROW(batch(3, 0, 0), std::out_of_range);
+  EXPECT_THROW(batch(0, 2, 0), std::out_of_range);
+  EXPECT_THROW(batch(0, 0, -1), std::out_of_range);
+  EXPECT_THROW(batch.Get(-1), std::out_of_range);
+  EXPECT_THROW(batch.Set(0, S21Matrix(2, 3)), std::invalid_argument);
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "s21_matrix_file.h"
+#include "s21_matrix_oop.h"
+
+namespace {
+
+std::string TempPath(const std::string& name) {
+  return (testing::TempDir() + "s21_matrix_file_test_" + name);
+}
+
+S21Matrix MakeMatrix(int rows, int cols) {
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      m(i, j) = i * 1000.0 + j + 0.125;
+    }
+  }
+
+  return (m);
+}
+
+void CorruptByte(const std::string& path, long offset) {
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  file.seekg(offset);
+  char byte = static_cast<char>(file.get());
+  file.seekp(offset);
+  file.put(static_cast<char>(byte ^ 0x5a));
+}
+
+}  // namespace
+
+TEST(MatrixFile, RoundTrip) {
+  const int kSizes[][2] = {{1, 1}, {3, 5}, {17, 9}, {300, 1000}};
+  std::string path = TempPath("round_trip");
+
+  for (const auto& size : kSizes) {
+    S21Matrix m = MakeMatrix(size[0], size[1]);
+    m.Save(path);
+    S21Matrix loaded = S21Matrix::Load(path, true);
+    EXPECT_EQ(loaded.storage(), S21Matrix::Storage::kAdopted);
+    EXPECT_EQ(loaded.rows(), size[0]);
+    EXPECT_EQ(loaded.cols(), size[1]);
+    EXPECT_TRUE(loaded == m);
+  }
+  std::remove(path.c_str());
+}
+
+TEST(MatrixFile, SaveBorrowedBlock) {
+  std::string path = TempPath("borrowed");
+  double buffer[6 * 20];
+  for (int i = 0; i < 6 * 20; ++i) {
+    buffer[i] = i;
+  }
+
+  S21Matrix::Borrow(buffer + 21, 4, 10, 20).Save(path);
+  S21Matrix loaded = S21Matrix::Load(path);
+  EXPECT_EQ(loaded.rows(), 4);
+  EXPECT_EQ(loaded.cols(), 10);
+  EXPECT_EQ(loaded(3, 9), 90.0);
+  std::remove(path.c_str());
+}
+
+TEST(MatrixFile, LoadedMatrixIsPrivate) {
+  std::string path = TempPath("private");
+  MakeMatrix(40, 40).Save(path);
+
+  {
+    S21Matrix loaded = S21Matrix::Load(path);
+    loaded(5, 5) = -1.0;
+    loaded += loaded;
+    EXPECT_EQ(loaded(5, 5), -2.0);
+  }
+  EXPECT_TRUE(S21Matrix::Load(path, true) == MakeMatrix(40, 40));
+  std::remove(path.c_str());
+}
+
+// Save replaces the file instead of truncating it, so a matrix mapped from
+// the old file keeps its elements, including the one being saved.
+TEST(MatrixFile, SaveOverLoadedFile) {
+  std::string path = TempPath("overwrite");
+  MakeMatrix(300, 40).Save(path);
+
+  S21Matrix loaded = S21Matrix::Load(path);
+  S21Matrix other = S21Matrix::Load(path);
+  loaded(0, 0) = 7.0;
+  loaded(299, 39) = -7.0;
+  loaded.Save(path);
+  EXPECT_EQ(loaded(0, 0), 7.0);
+  EXPECT_TRUE(other == MakeMatrix(300, 40));
+  EXPECT_TRUE(S21Matrix::Load(path, true) == loaded);
+
+  other.Save(path);
+  EXPECT_TRUE(S21Matrix::Load(path, true) == MakeMatrix(300, 40));
+  std::remove(path.c_str());
+}
+
+TEST(MatrixFile, Header) {
+  std::string path = TempPath("header");
+  MakeMatrix(10, 12).Save(path);
+
+  s21::FileHeader header = s21::File::OpenForReading(path).ReadHeader();
+  EXPECT_EQ(header.version, s21::kFileVersion);
+  EXPECT_EQ(header.rows, 10);
+  EXPECT_EQ(header.cols, 12);
+  EXPECT_EQ(header.stride, 16);
+  EXPECT_EQ(header.data_offset % 64, 0u);
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  EXPECT_EQ(static_cast<std::uint64_t>(file.tellg()),
+            header.data_offset + 10 * 16 * sizeof(double));
+  std::remove(path.c_str());
+}
+
+TEST(MatrixFile, Corrupted) {
+  std::string path = TempPath("corrupted");
+  MakeMatrix(8, 8).Save(path);
+
+  CorruptByte(path, 64 + 3 * sizeof(double));
+  EXPECT_NO_THROW(S21Matrix::Load(path));
+  EXPECT_THROW(S21Matrix::Load(path, true), std::runtime_error);
+  CorruptByte(path, 0);
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(MatrixFile, Truncated) {
+  std::string path = TempPath("truncated");
+  MakeMatrix(8, 8).Save(path);
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(in)),
+                         std::istreambuf_iterator<char>());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(contents.data(),
+              static_cast<std::streamsize>(contents.size() - 8));
+  }
+
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(MatrixFile, SaveMovedFrom) {
+  S21Matrix m = MakeMatrix(3, 4);
+  S21Matrix other(std::move(m));
+  std::string path = TempPath("moved");
+
+  EXPECT_THROW(m.Save(path), std::invalid_argument);
+  other.Save(path);
+  EXPECT_TRUE(S21Matrix::Load(path) == other);
+  std::remove(path.c_str());
+}
+
+TEST(MatrixFile, Missing) {
+  EXPECT_THROW(S21Matrix::Load(TempPath("missing")), std::system_error);
+  EXPECT_THROW(MakeMatrix(2, 2).Save("/nonexistent/dir/matrix.bin"),
+               std::system_error);
+}
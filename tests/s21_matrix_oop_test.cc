@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <type_traits>
 #include <utility>
 
 #include "s21_matrix_oop.h"
@@ -98,6 +102,44 @@ TEST(MatrixConstructorDestructor, MoveConstructor) {
   }
 }
 
+TEST(MatrixConstructorDestructor, MoveInlineStorage) {
+  S21Matrix m(3, 4);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      m(i, j) = i * 4.0 + j;
+    }
+  }
+
+  S21Matrix copy(m);
+  S21Matrix move(std::move(copy));
+  copy = S21Matrix(2, 2);
+  EXPECT_EQ(copy.rows(), 2);
+  EXPECT_TRUE(move == m);
+  move(2, 3) = -1.0;
+  EXPECT_EQ(m(2, 3), 11.0);
+}
+
+TEST(MatrixConstructorDestructor, SwapInlineAndHeapStorage) {
+  S21Matrix small(2, 3);
+  S21Matrix large(20, 30);
+  small(1, 2) = 5.0;
+  large(19, 29) = 7.0;
+
+  S21Matrix tmp(std::move(small));
+  small = std::move(large);
+  large = std::move(tmp);
+  EXPECT_EQ(small.rows(), 20);
+  EXPECT_EQ(small(19, 29), 7.0);
+  EXPECT_EQ(large.rows(), 2);
+  EXPECT_EQ(large(1, 2), 5.0);
+
+  large.set_rows(10);
+  EXPECT_EQ(large(1, 2), 5.0);
+  large.set_rows(1);
+  EXPECT_EQ(large.rows(), 1);
+  EXPECT_EQ(large(0, 2), 0.0);
+}
+
 // Tests for accessors and mutators
 
 TEST(MatrixAccessorMutator, RowsColsAccessor) {
@@ -260,6 +302,33 @@ TEST(MatrixAccessorMutator, EqualColsMutator) {
   }
 }
 
+TEST(MatrixAccessorMutator, ColsMutatorAcrossPadding) {
+  int rows = 5;
+  S21Matrix m(rows, 7);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < 7; ++j) {
+      m(i, j) = i * 10.0 + j;
+    }
+  }
+
+  m.set_cols(19);
+  S21Matrix sum = m + m;
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < 19; ++j) {
+      EXPECT_EQ(m(i, j), j < 7 ? i * 10.0 + j : 0.0);
+      EXPECT_EQ(sum(i, j), 2.0 * m(i, j));
+    }
+  }
+
+  m.set_cols(3);
+  m.set_cols(8);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < 8; ++j) {
+      EXPECT_EQ(m(i, j), j < 3 ? i * 10.0 + j : 0.0);
+    }
+  }
+}
+
 TEST(MatrixAccessorMutator, BadColsMutator) {
   int rows = 91;
   int cols = 14;
@@ -271,6 +340,50 @@ TEST(MatrixAccessorMutator, BadColsMutator) {
   EXPECT_THROW(m.set_cols(new_cols), std::invalid_argument);
 }
 
+// Tests for thread count
+
+TEST(MatrixThreadCount, SetThreadCount) {
+  int count = S21Matrix::thread_count();
+
+  S21Matrix::set_thread_count(3);
+  EXPECT_EQ(S21Matrix::thread_count(), 3);
+  S21Matrix::set_thread_count(count);
+  EXPECT_EQ(S21Matrix::thread_count(), count);
+}
+
+TEST(MatrixThreadCount, BadThreadCount) {
+  EXPECT_THROW(S21Matrix::set_thread_count(0), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::set_thread_count(-4), std::invalid_argument);
+}
+
+TEST(MatrixThreadCount, SameResults) {
+  int count = S21Matrix::thread_count();
+  int n = 301;
+  S21Matrix m1(n, n);
+  S21Matrix m2(n, n + 17);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      m1(i, j) = ((i * 11 + j * 5) % 23 - 11.0) / 16.0;
+    }
+    m1(i, i) += 4.0;
+    for (int j = 0; j < n + 17; ++j) {
+      m2(i, j) = ((i * 3 + j * 13) % 19 - 9.0) / 8.0;
+    }
+  }
+
+  S21Matrix::set_thread_count(1);
+  S21Matrix product = m1 * m2;
+  S21Matrix inverse = m1.InverseMatrix();
+  double det = m1.Determinant();
+
+  S21Matrix::set_thread_count(4);
+  EXPECT_TRUE(product == m1 * m2);
+  EXPECT_TRUE(inverse == m1.InverseMatrix());
+  EXPECT_NEAR(1.0, m1.Determinant() / det, 1.0e-12);
+
+  S21Matrix::set_thread_count(count);
+}
+
 // Tests for EqMatrix
 
 TEST(MatrixEq, OtherCols) {
@@ -532,6 +645,39 @@ TEST(MatrixMulMatrix, RectangleMatrices) {
   }
 }
 
+TEST(MatrixMulMatrix, LargeRectangleMatrices) {
+  int rows = 203;
+  int inner = 517;
+  int cols = 4099;
+  S21Matrix m1(rows, inner);
+  S21Matrix m2(inner, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int k = 0; k < inner; ++k) {
+      m1(i, k) = ((i * 7 + k * 3) % 13 - 6.0) / 4.0;
+    }
+  }
+  for (int k = 0; k < inner; ++k) {
+    for (int j = 0; j < cols; ++j) {
+      m2(k, j) = ((k * 5 + j * 11) % 17 - 8.0) / 8.0;
+    }
+  }
+
+  S21Matrix m3 = m1 * m2;
+  m1.MulMatrix(m2);
+  EXPECT_EQ(m1.rows(), rows);
+  EXPECT_EQ(m1.cols(), cols);
+  for (int i = 0; i < rows; i += 29) {
+    for (int j = 0; j < cols; ++j) {
+      double sum = 0.0;
+      for (int k = 0; k < inner; ++k) {
+        sum += m2(k, j) * ((i * 7 + k * 3) % 13 - 6.0) / 4.0;
+      }
+      EXPECT_NEAR(m1(i, j), sum, S21Matrix::kEps);
+      EXPECT_NEAR(m3(i, j), sum, S21Matrix::kEps);
+    }
+  }
+}
+
 // Tests for Transpose
 
 TEST(MatrixTranspose, SquareMatrix) {
@@ -688,6 +834,61 @@ TEST(MatrixCalcComplements, Matrix5x5) {
   EXPECT_TRUE(comp == mb);
 }
 
+namespace {
+
+// Cofactors by definition, for checking the orders above the expansion.
+S21Matrix Cofactors(const S21Matrix& m) {
+  int n = m.rows();
+  S21Matrix cofactors(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      S21Matrix minor(n - 1, n - 1);
+      for (int r = 0; r < n - 1; ++r) {
+        for (int c = 0; c < n - 1; ++c) {
+          minor(r, c) = m(r < i ? r : r + 1, c < j ? c : c + 1);
+        }
+      }
+      cofactors(i, j) = ((i + j) % 2 ? -1.0 : 1.0) * minor.Determinant();
+    }
+  }
+
+  return (cofactors);
+}
+
+}  // namespace
+
+TEST(MatrixCalcComplements, AboveCofactorExpansion) {
+  S21Matrix m(9, 9);
+  for (int i = 0; i < 9; ++i) {
+    for (int j = 0; j < 9; ++j) {
+      m(i, j) = (i * 5 + j * 3) % 7 - 3.0 + (i == j ? 10.0 : 0.0);
+    }
+  }
+
+  S21Matrix expected = Cofactors(m);
+  S21Matrix complements = m.CalcComplements();
+  for (int i = 0; i < 9; ++i) {
+    for (int j = 0; j < 9; ++j) {
+      EXPECT_NEAR(complements(i, j), expected(i, j),
+                  1e-9 * std::abs(expected(i, j)) + 1e-6);
+    }
+  }
+
+  // A singular matrix of rank n - 1 still has a nonzero adjugate.
+  for (int j = 0; j < 9; ++j) {
+    m(8, j) = m(0, j) + m(1, j);
+  }
+  expected = Cofactors(m);
+  complements = m.CalcComplements();
+  EXPECT_GT(std::abs(expected(8, 8)), 1.0);
+  for (int i = 0; i < 9; ++i) {
+    for (int j = 0; j < 9; ++j) {
+      EXPECT_NEAR(complements(i, j), expected(i, j),
+                  1e-9 * std::abs(expected(i, j)) + 1e-6);
+    }
+  }
+}
+
 TEST(MatrixCalcComplements, RectangleMatrix) {
   S21Matrix m1(19, 18);
   S21Matrix m2(21, 43);
@@ -785,6 +986,87 @@ TEST(MatrixDeterminant, Matrix6x6_2) {
   EXPECT_NEAR(dt, m.Determinant(), S21Matrix::kEps);
 }
 
+TEST(MatrixDeterminant, ZeroLeadingPivot) {
+  double a[4][4] = {{0.0, 2.0, 1.0, 3.0},
+                    {1.0, 0.0, 4.0, 2.0},
+                    {3.0, 1.0, 0.0, 5.0},
+                    {2.0, 4.0, 1.0, 0.0}};
+  double dt = -205.0;
+
+  S21Matrix m(4, 4);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      m(i, j) = a[i][j];
+    }
+  }
+  EXPECT_NEAR(dt, m.Determinant(), S21Matrix::kEps);
+  EXPECT_EQ(dt, m.ExactDeterminant());
+}
+
+TEST(MatrixDeterminant, LargeTriangularMatrix) {
+  int n = 200;
+  S21Matrix m(n, n);
+  double dt = 1.0;
+  for (int i = 0; i < n; ++i) {
+    m(i, i) = 1.0 + (i % 3) * 0.5;
+    dt *= m(i, i);
+    for (int j = 0; j < i; ++j) {
+      m(j, i) = (i * 7 + j * 3) % 11 - 5.0;
+    }
+  }
+
+  EXPECT_NEAR(1.0, m.Determinant() / dt, 1.0e-9);
+}
+
+TEST(MatrixDeterminant, LargePermutedMatrix) {
+  int n = 64;
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i) {
+    m(i, (i + 1) % n) = 2.0;
+  }
+
+  // A cyclic shift of 64 rows is an odd permutation.
+  EXPECT_NEAR(-std::pow(2.0, n), m.Determinant(), S21Matrix::kEps);
+}
+
+TEST(MatrixDeterminant, ExactMatrix5x5) {
+  double a[5][5] = {{78., 951., 147., 47., 52.},
+                    {76., 98., 78., 753., -89.},
+                    {87., 457., 253., 984., -71.},
+                    {47., 453., 786., 123., 357.},
+                    {765., -896., 783., 478., 456}};
+
+  S21Matrix m(5, 5);
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      m(i, j) = a[i][j];
+    }
+  }
+
+  double exact = m.ExactDeterminant();
+  EXPECT_EQ(exact, std::round(exact));
+  EXPECT_NEAR(1.0, m.Determinant() / exact, 1.0e-12);
+}
+
+TEST(MatrixDeterminant, ExactRectangleMatrix) {
+  S21Matrix m(3, 4);
+
+  EXPECT_THROW(m.ExactDeterminant(), std::invalid_argument);
+}
+
+TEST(MatrixDeterminant, ExactTooLarge) {
+  int n = S21Matrix::kExactDeterminantMaxSize;
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i) {
+    m(i, i) = 2.0;
+  }
+  EXPECT_EQ(m.ExactDeterminant(), std::pow(2.0, n));
+
+  m.set_rows(n + 1);
+  m.set_cols(n + 1);
+  EXPECT_THROW(m.ExactDeterminant(), std::invalid_argument);
+}
+
 TEST(MatrixDeterminant, RectangleMatrix) {
   S21Matrix m1(1, 2);
   S21Matrix m2(115, 23);
@@ -853,6 +1135,55 @@ TEST(MatrixInverse, Matrix6x6) {
   }
 }
 
+TEST(MatrixInverse, ZeroLeadingPivot) {
+  double a[3][3] = {{0.0, 1.0, 2.0}, {1.0, 0.0, 3.0}, {4.0, -3.0, 8.0}};
+  double b[3][3] = {{-4.5, 7.0, -1.5}, {-2.0, 4.0, -1.0}, {1.5, -2.0, 0.5}};
+
+  S21Matrix ma(3, 3);
+  S21Matrix mb(3, 3);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      ma(i, j) = a[i][j];
+      mb(i, j) = b[i][j];
+    }
+  }
+
+  EXPECT_TRUE(ma.InverseMatrix() == mb);
+}
+
+TEST(MatrixInverse, SmallDeterminant) {
+  int n = 4;
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i) {
+    m(i, i) = 0.01;
+  }
+
+  S21Matrix inverse = m.InverseMatrix();
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      EXPECT_NEAR(inverse(i, j), i == j ? 100.0 : 0.0, S21Matrix::kEps);
+    }
+  }
+}
+
+TEST(MatrixInverse, LargeMatrix) {
+  int n = 120;
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      m(i, j) = ((i * 13 + j * 7) % 17 - 8.0) / 16.0;
+    }
+    m(i, i) += n / 4.0;
+  }
+
+  S21Matrix product = m * m.InverseMatrix();
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      EXPECT_NEAR(product(i, j), i == j ? 1.0 : 0.0, S21Matrix::kEps);
+    }
+  }
+}
+
 TEST(MatrixInverse, NoExist) {
   double a[3][3] = {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}, {5.0, 7.0, 9.0}};
 
@@ -1575,6 +1906,318 @@ TEST(MatrixOperatorParentheses, NormalIndex) {
   EXPECT_EQ(m2(17, 54), 0.0);
 }
 
+// Tests for unchecked access
+
+TEST(MatrixUncheckedAccess, SameElements) {
+  S21Matrix m1(13, 11);
+  for (int i = 0; i < m1.rows(); ++i) {
+    for (int j = 0; j < m1.cols(); ++j) {
+      m1(i, j) = i * 100.0 + j;
+    }
+  }
+  const S21Matrix& m2 = m1;
+
+  EXPECT_GE(m1.stride(), m1.cols());
+  for (int i = 0; i < m1.rows(); ++i) {
+    for (int j = 0; j < m1.cols(); ++j) {
+      EXPECT_EQ(&m1.At(i, j), &m1(i, j));
+      EXPECT_EQ(&m2.At(i, j), &m2(i, j));
+      EXPECT_EQ(&m1[i][j], &m1(i, j));
+      EXPECT_EQ(&m2[i][j], &m2(i, j));
+      EXPECT_EQ(&m1.data()[i * m1.stride() + j], &m1(i, j));
+    }
+  }
+
+  m1.At(3, 4) = -1.0;
+  m1[5][6] = -2.0;
+  EXPECT_EQ(m2(3, 4), -1.0);
+  EXPECT_EQ(m2.At(5, 6), -2.0);
+}
+
+TEST(MatrixUncheckedAccess, Rows) {
+  S21Matrix m1(9, 10);
+  int i = 0;
+  for (double* row : m1.Rows()) {
+    EXPECT_EQ(row, m1[i]);
+    for (int j = 0; j < m1.cols(); ++j) {
+      row[j] = i + j;
+    }
+    ++i;
+  }
+  EXPECT_EQ(i, 9);
+  EXPECT_EQ(m1(8, 9), 17.0);
+
+  const S21Matrix& m2 = m1;
+  S21MatrixRows<const double> rows = m2.Rows();
+  EXPECT_EQ(rows.size(), 9);
+  EXPECT_EQ(rows.end() - rows.begin(), 9);
+  EXPECT_EQ(rows.begin()[4], m2[4]);
+  EXPECT_EQ(*(rows.end() - 1), m2[8]);
+  EXPECT_TRUE(rows.begin() < rows.end());
+}
+
+TEST(MatrixUncheckedAccess, RowIterator) {
+  S21Matrix m1(7, 3);
+  m1(5, 1) = 2.5;
+  S21MatrixRows<double> rows = m1.Rows();
+  S21MatrixRowIterator<double> it = 2 + rows.begin();
+
+  EXPECT_EQ(*it, m1[2]);
+  EXPECT_TRUE(it > rows.begin());
+  EXPECT_TRUE(it >= it);
+  EXPECT_TRUE(it <= rows.end());
+  EXPECT_FALSE(it > rows.end());
+  EXPECT_EQ(std::distance(rows.begin(), rows.end()), 7);
+  auto found = std::find_if(rows.begin(), rows.end(),
+                            [](double* row) { return (row[1] == 2.5); });
+  EXPECT_EQ(found - rows.begin(), 5);
+
+  S21Matrix m2(std::move(m1));
+  rows = m1.Rows();
+  EXPECT_EQ(rows.end() - rows.begin(), 0);
+  EXPECT_TRUE(rows.begin() == rows.end());
+}
+
+#ifdef S21_MATRIX_CHECK_BOUNDS
+TEST(MatrixUncheckedAccess, CheckedInDebugBuilds) {
+  S21Matrix m1(4, 5);
+  const S21Matrix m2(4, 5);
+
+  EXPECT_THROW(m1.At(4, 0), std::out_of_range);
+  EXPECT_THROW(m1.At(0, -1), std::out_of_range);
+  EXPECT_THROW(m2.At(-1, 0), std::out_of_range);
+  EXPECT_THROW(m2.At(0, 5), std::out_of_range);
+  EXPECT_THROW(m1[4], std::out_of_range);
+  EXPECT_THROW(m2[-1], std::out_of_range);
+}
+#endif
+
+// Tests for external storage
+
+TEST(MatrixExternalStorage, StorageKinds) {
+  S21Matrix small(2, 2), large(20, 20);
+  double buffer[6] = {};
+
+  EXPECT_EQ(small.storage(), S21Matrix::Storage::kInline);
+  EXPECT_EQ(large.storage(), S21Matrix::Storage::kHeap);
+  EXPECT_EQ(S21Matrix::Borrow(buffer, 2, 3, 3).storage(),
+            S21Matrix::Storage::kBorrowed);
+}
+
+TEST(MatrixExternalStorage, BorrowSharesBuffer) {
+  double buffer[4 * 10];
+  for (int i = 0; i < 40; ++i) {
+    buffer[i] = i;
+  }
+
+  S21Matrix m = S21Matrix::Borrow(buffer + 12, 3, 5, 10);
+  EXPECT_EQ(m(0, 0), 12.0);
+  EXPECT_EQ(m(2, 4), 36.0);
+  m(1, 1) = -1.0;
+  m *= 2.0;
+  EXPECT_EQ(buffer[23], -2.0);
+  EXPECT_EQ(buffer[17], 17.0);
+  buffer[34] = 0.5;
+  EXPECT_EQ(m(2, 2), 0.5);
+
+  S21Matrix copy(m);
+  EXPECT_EQ(copy.storage(), S21Matrix::Storage::kInline);
+  copy(0, 0) = 100.0;
+  EXPECT_EQ(buffer[12], 24.0);
+  EXPECT_TRUE(m * S21Matrix(5, 2) == S21Matrix(3, 2));
+
+  m.set_cols(7);
+  EXPECT_EQ(m.storage(), S21Matrix::Storage::kHeap);
+  EXPECT_EQ(m(2, 4), 72.0);
+  EXPECT_EQ(buffer[37], 37.0);
+}
+
+TEST(MatrixExternalStorage, BorrowKeepsResults) {
+  double buffer[3 * 3] = {1, 2, 0, 0, 1, 0, 0, 0, 2};
+  S21Matrix m = S21Matrix::Borrow(buffer, 3, 3, 3);
+  S21Matrix a(3, 3);
+  a(0, 0) = a(1, 1) = a(2, 2) = 3.0;
+
+  m.MulMatrix(a);
+  EXPECT_EQ(m.storage(), S21Matrix::Storage::kBorrowed);
+  EXPECT_EQ(buffer[1], 6.0);
+  m.MulMatrix(a, S21Matrix::Multiplication::kStrassen);
+  EXPECT_EQ(buffer[8], 18.0);
+  m *= a;
+  EXPECT_EQ(buffer[0], 27.0);
+  m = a * a;
+  EXPECT_EQ(m.storage(), S21Matrix::Storage::kBorrowed);
+  EXPECT_EQ(buffer[1], 0.0);
+  EXPECT_EQ(buffer[4], 9.0);
+  m = a;
+  EXPECT_EQ(buffer[4], 3.0);
+
+  m.MulMatrix(S21Matrix(3, 2));
+  EXPECT_EQ(m.storage(), S21Matrix::Storage::kInline);
+  EXPECT_EQ(buffer[4], 3.0);
+}
+
+TEST(MatrixExternalStorage, AdoptReleasesOnce) {
+  int released = 0;
+  double* buffer = new double[64]();
+  {
+    S21Matrix m = S21Matrix::Adopt(buffer, 8, 8, 8, [&](double* data) {
+      ++released;
+      delete[] data;
+    });
+    EXPECT_EQ(m.storage(), S21Matrix::Storage::kAdopted);
+    m(7, 7) = 3.0;
+
+    S21Matrix moved(std::move(m));
+    EXPECT_EQ(moved.storage(), S21Matrix::Storage::kAdopted);
+    EXPECT_EQ(moved(7, 7), 3.0);
+
+    S21Matrix other(2, 2);
+    other = std::move(moved);
+    EXPECT_EQ(released, 0);
+    moved = S21Matrix(3, 3);
+    EXPECT_EQ(released, 0);
+  }
+  EXPECT_EQ(released, 1);
+}
+
+TEST(MatrixExternalStorage, InvalidArguments) {
+  double buffer[8] = {};
+
+  EXPECT_THROW(S21Matrix::Borrow(nullptr, 2, 2, 2), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::Borrow(buffer, 0, 2, 2), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::Borrow(buffer, 2, 0, 2), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::Borrow(buffer, 2, 4, 3), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::Adopt(buffer, 2, 4, 4, nullptr),
+               std::invalid_argument);
+}
+
+// Tests for chained expressions
+
+TEST(MatrixExpression, ChainedArithmetic) {
+  S21Matrix a(13, 21), b(13, 21), c(13, 21);
+  S21Matrix expected(13, 21);
+
+  for (int i = 0; i < 13; ++i) {
+    for (int j = 0; j < 21; ++j) {
+      a(i, j) = i * 1.5 - j;
+      b(i, j) = j * 0.25 + 3.0;
+      c(i, j) = i - j * 2.0;
+      expected(i, j) = (a(i, j) + b(i, j) - c(i, j) * 2.0) * 0.5;
+    }
+  }
+
+  S21Matrix result = (a + b - c * 2.0) * 0.5;
+  EXPECT_TRUE(result == expected);
+  EXPECT_TRUE(expected == 0.5 * (a + b) - c);
+  result = a;
+  result += b - 2.0 * c;
+  result -= a;
+  EXPECT_TRUE(result == b - c * 2.0);
+  EXPECT_TRUE((a + b) * S21Matrix(21, 4) == S21Matrix(13, 4));
+}
+
+TEST(MatrixExpression, AliasedAssignment) {
+  S21Matrix a(3, 40), expected(3, 40);
+
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 40; ++j) {
+      a(i, j) = i + j * 0.5;
+      expected(i, j) = a(i, j) * 3.0 - a(i, j) * 0.5;
+    }
+  }
+
+  a = a + a * 2.0 - a * 0.5;
+  EXPECT_TRUE(a == expected);
+  a += a;
+  EXPECT_TRUE(a == expected * 2.0);
+}
+
+TEST(MatrixExpression, AliasedSumOfMatrices) {
+  S21Matrix a(5, 37), b(5, 37);
+
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 37; ++j) {
+      a(i, j) = i * 2.5 - j;
+      b(i, j) = j * 0.75 + i;
+    }
+  }
+
+  S21Matrix sum = a + b, difference = a - b, result(a);
+  result = result + b;
+  EXPECT_TRUE(result == sum);
+  result = a;
+  result = b + result;
+  EXPECT_TRUE(result == sum);
+  result = a;
+  result = result - b;
+  EXPECT_TRUE(result == difference);
+  result = b;
+  result = a - result;
+  EXPECT_TRUE(result == difference);
+  result = a - std::move(result);
+  EXPECT_TRUE(result == b);
+  result = result - result;
+  EXPECT_TRUE(result == S21Matrix(5, 37));
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 37; ++j) {
+      EXPECT_EQ(sum(i, j), a(i, j) + b(i, j));
+      EXPECT_EQ(difference(i, j), a(i, j) - b(i, j));
+    }
+  }
+}
+
+TEST(MatrixExpression, ResizingAssignment) {
+  S21Matrix a(2, 2), b(5, 7), c(5, 7);
+  b(4, 6) = 1.5;
+  c(4, 6) = 2.0;
+
+  a = b + c;
+  EXPECT_EQ(a.rows(), 5);
+  EXPECT_EQ(a.cols(), 7);
+  EXPECT_EQ(a(4, 6), 3.5);
+}
+
+TEST(MatrixExpression, DifferentDimensions) {
+  S21Matrix a(4, 5), b(4, 5), c(5, 4);
+
+  EXPECT_THROW(a + b - c, std::invalid_argument);
+  EXPECT_THROW(c * 2.0 + (a + b), std::invalid_argument);
+  EXPECT_THROW(a += b - c, std::invalid_argument);
+  EXPECT_THROW(a -= c * 2.0, std::invalid_argument);
+}
+
+// The call shapes of the time when + and - returned a matrix still compile
+// and evaluate the expression first.
+TEST(MatrixExpression, MatrixMembers) {
+  S21Matrix a(3, 3), b(3, 3), c(3, 3);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      a(i, j) = i * 3 + j;
+      b(i, j) = i == j ? 2.0 : 0.0;
+      c(i, j) = a(i, j) + b(i, j);
+    }
+  }
+
+  static_assert(std::is_same<decltype((a + b).Transpose()), S21Matrix>::value,
+                "Transpose of an expression is a matrix.");
+  static_assert(std::is_same<decltype((a - b)(0, 0)), double>::value,
+                "An element of an expression is a value.");
+  EXPECT_TRUE((a + b).EqMatrix(c));
+  EXPECT_TRUE((c - b).EqMatrix(a));
+  EXPECT_FALSE((a * 2.0).EqMatrix(c));
+  EXPECT_TRUE((a + b).EqMatrix(c - b + b));
+  EXPECT_EQ((a - b)(0, 0), -2.0);
+  EXPECT_EQ((a + b)(2, 1), 7.0);
+  EXPECT_THROW((a + b)(3, 0), std::out_of_range);
+  EXPECT_THROW((a + b)(0, -1), std::out_of_range);
+  EXPECT_TRUE((a + b).Transpose() == c.Transpose());
+  EXPECT_DOUBLE_EQ((a + b).Determinant(), c.Determinant());
+  EXPECT_TRUE((a * 1.0 + b).CalcComplements() == c.CalcComplements());
+  EXPECT_TRUE((a + b).InverseMatrix() == c.InverseMatrix());
+  EXPECT_TRUE((a + b).Eval() == c);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
 
@@ -0,0 +1,166 @@
+#include "s21_matrix_stats.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+// The counters are global, so every test resets them first. Tests of the
+// collected values only run in builds with S21_MATRIX_INSTRUMENT.
+
+namespace {
+
+typedef S21MatrixStats::Operation Operation;
+
+S21Matrix MakeMatrix(int n) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      m(i, j) = (i * 7 + j * 3) % 5 + (i == j ? n : 0);
+    }
+  }
+
+  return (m);
+}
+
+void RunOperations(void) {
+  S21Matrix a = MakeMatrix(8);
+  S21Matrix b = MakeMatrix(8);
+  a.SumMatrix(b);
+  S21Matrix c = a * b;
+  c.Determinant();
+}
+
+std::uint64_t BucketSum(const S21MatrixStats::Counters& counters) {
+  std::uint64_t sum = 0;
+  for (std::uint64_t count : counters.latency_buckets) {
+    sum += count;
+  }
+
+  return (sum);
+}
+
+}  // namespace
+
+TEST(MatrixStats, DisabledStatsStayZero) {
+  if (S21MatrixStats::enabled()) {
+    GTEST_SKIP() << "built with S21_MATRIX_INSTRUMENT";
+  }
+  S21MatrixStats::Reset();
+  RunOperations();
+
+  S21MatrixStats stats = S21MatrixStats::Snapshot();
+  for (int op = 0; op < S21MatrixStats::kOperations; ++op) {
+    EXPECT_EQ(stats[static_cast<Operation>(op)].calls, 0u);
+    EXPECT_EQ(BucketSum(stats[static_cast<Operation>(op)]), 0u);
+  }
+}
+
+TEST(MatrixStats, CountsOperations) {
+  if (!S21MatrixStats::enabled()) {
+    GTEST_SKIP() << "built without S21_MATRIX_INSTRUMENT";
+  }
+  S21MatrixStats::Reset();
+  RunOperations();
+
+  S21MatrixStats stats = S21MatrixStats::Snapshot();
+  EXPECT_EQ(stats[Operation::kSumMatrix].calls, 1u);
+  EXPECT_EQ(stats[Operation::kSumMatrix].elements, 128u);
+  EXPECT_EQ(stats[Operation::kSumMatrix].allocations, 0u);
+
+  // The product allocates its result, the determinant a scratch copy.
+  const S21MatrixStats::Counters& product = stats[Operation::kMulMatrix];
+  EXPECT_EQ(product.calls, 1u);
+  EXPECT_EQ(product.elements, 128u);
+  EXPECT_EQ(product.allocations, 1u);
+  EXPECT_EQ(product.bytes_allocated, 64 * sizeof(double));
+  EXPECT_EQ(stats[Operation::kDeterminant].allocations, 1u);
+  EXPECT_EQ(stats[Operation::kCopyMatrix].calls, 1u);
+  EXPECT_EQ(stats[Operation::kAllocateMatrix].calls, 4u);
+  EXPECT_EQ(stats[Operation::kAllocateMatrix].bytes_allocated,
+            4 * 64 * sizeof(double));
+  EXPECT_EQ(stats[Operation::kInverseMatrix].calls, 0u);
+
+  for (int op = 0; op < S21MatrixStats::kOperations; ++op) {
+    const S21MatrixStats::Counters& counters =
+        stats[static_cast<Operation>(op)];
+    EXPECT_EQ(BucketSum(counters), counters.calls) << op;
+  }
+
+  S21MatrixStats::Reset();
+  EXPECT_EQ(S21MatrixStats::Snapshot()[Operation::kMulMatrix].calls, 0u);
+}
+
+TEST(MatrixStats, CountsExpressionOperators) {
+  if (!S21MatrixStats::enabled()) {
+    GTEST_SKIP() << "built without S21_MATRIX_INSTRUMENT";
+  }
+  S21Matrix a = MakeMatrix(8);
+  S21Matrix b = MakeMatrix(8);
+  S21MatrixStats::Reset();
+  S21Matrix sum = a + b;
+  S21Matrix difference = a - b;
+  difference = sum - a;
+
+  S21MatrixStats stats = S21MatrixStats::Snapshot();
+  EXPECT_EQ(stats[Operation::kSumMatrix].calls, 1u);
+  EXPECT_EQ(stats[Operation::kSumMatrix].elements, 128u);
+  EXPECT_EQ(stats[Operation::kSubMatrix].calls, 2u);
+  EXPECT_EQ(stats[Operation::kCopyMatrix].calls, 3u);
+  EXPECT_EQ(stats[Operation::kAllocateMatrix].calls, 2u);
+}
+
+TEST(MatrixStats, Json) {
+  S21MatrixStats::Reset();
+  RunOperations();
+  std::string json = S21MatrixStats::Snapshot().ToJson();
+
+  EXPECT_NE(json.find(std::string("\"enabled\": ") +
+                      (S21MatrixStats::enabled() ? "true" : "false")),
+            std::string::npos);
+  EXPECT_NE(json.find("\"inverse_matrix\": {\"calls\": 0, \"elements\": 0"),
+            std::string::npos);
+  EXPECT_NE(json.find("{\"le\": 1e-07, \"count\": "), std::string::npos);
+  EXPECT_NE(json.find("{\"le\": \"+Inf\", \"count\": 0}"), std::string::npos);
+  if (S21MatrixStats::enabled()) {
+    EXPECT_NE(json.find("\"sum_matrix\": {\"calls\": 1, \"elements\": 128"),
+              std::string::npos);
+  }
+}
+
+TEST(MatrixStats, Prometheus) {
+  S21MatrixStats::Reset();
+  RunOperations();
+  std::string text = S21MatrixStats::Snapshot().ToPrometheus();
+
+  EXPECT_NE(text.find("# TYPE s21_matrix_calls_total counter\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("# TYPE s21_matrix_operation_duration_seconds "
+                      "histogram\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("s21_matrix_operation_duration_seconds_bucket{"
+                      "operation=\"determinant\",le=\"1e-07\"} "),
+            std::string::npos);
+  std::string calls = S21MatrixStats::enabled() ? "1" : "0";
+  EXPECT_NE(text.find("s21_matrix_calls_total{operation=\"mul_matrix\"} " +
+                      calls + "\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("s21_matrix_operation_duration_seconds_bucket{"
+                      "operation=\"mul_matrix\",le=\"+Inf\"} " +
+                      calls + "\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("s21_matrix_operation_duration_seconds_count{"
+                      "operation=\"mul_matrix\"} " +
+                      calls + "\n"),
+            std::string::npos);
+}
+
+TEST(MatrixStats, Names) {
+  EXPECT_STREQ(S21MatrixStats::Name(Operation::kAllocateMatrix),
+               "allocate_matrix");
+  EXPECT_STREQ(S21MatrixStats::Name(Operation::kInverseMatrix),
+               "inverse_matrix");
+  EXPECT_THROW(S21MatrixStats::Snapshot()[Operation::kCount],
+               std::out_of_range);
+}
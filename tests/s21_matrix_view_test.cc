@@ -0,0 +1,155 @@
+#include "s21_matrix_view.h"
+
+#include <gtest/gtest.h>
+
+#include "s21_test_helpers.h"
+
+namespace {
+
+using s21::test::MakeMatrix;
+
+S21Matrix NaiveProduct(const S21ConstMatrixView& a,
+                       const S21ConstMatrixView& b) {
+  S21Matrix c(a.rows(), b.cols());
+  for (int i = 0; i < a.rows(); ++i) {
+    for (int j = 0; j < b.cols(); ++j) {
+      for (int k = 0; k < a.cols(); ++k) {
+        c(i, j) += a(i, k) * b(k, j);
+      }
+    }
+  }
+
+  return (c);
+}
+
+}  // namespace
+
+TEST(MatrixView, SharesStorage) {
+  S21Matrix m = MakeMatrix(12, 20, 0);
+  S21MatrixView view = m;
+
+  EXPECT_EQ(view.rows(), 12);
+  EXPECT_EQ(view.cols(), 20);
+  EXPECT_EQ(&view(0, 0), &m(0, 0));
+  EXPECT_EQ(&view.Block(3, 4, 5, 6)(1, 2), &m(4, 6));
+  EXPECT_EQ(&view.Row(7)(0, 11), &m(7, 11));
+  EXPECT_EQ(&view.Col(9)(10, 0), &m(10, 9));
+  EXPECT_EQ(&view.Transposed()(15, 2), &m(2, 15));
+
+  view.Block(1, 1, 2, 2)(1, 1) = 42.0;
+  EXPECT_EQ(m(2, 2), 42.0);
+}
+
+TEST(MatrixView, OutOfRange) {
+  S21Matrix m(6, 5);
+  S21ConstMatrixView view = m;
+
+  EXPECT_THROW(view.Block(4, 0, 3, 1), std::out_of_range);
+  EXPECT_THROW(view.Block(0, -1, 1, 1), std::out_of_range);
+  EXPECT_THROW(view.Block(0, 0, 1, 6), std::out_of_range);
+  EXPECT_THROW(view.Row(6), std::out_of_range);
+  EXPECT_THROW(view.Col(5), std::out_of_range);
+  EXPECT_THROW(view.Block(2, 2, 2, 2)(2, 0), std::out_of_range);
+  EXPECT_THROW(S21ConstMatrixView(m.View().data(), -1, 2, 2),
+               std::invalid_argument);
+  EXPECT_NO_THROW(view.Block(6, 5, 0, 0));
+}
+
+TEST(MatrixView, Materialize) {
+  S21Matrix m = MakeMatrix(9, 14, 1);
+  S21Matrix transposed = m.View().Transposed();
+  S21Matrix block = m.View().Block(2, 3, 4, 5);
+
+  EXPECT_TRUE(transposed == m.Transpose());
+  EXPECT_EQ(block.rows(), 4);
+  EXPECT_EQ(block.cols(), 5);
+  EXPECT_EQ(block(3, 4), m(5, 7));
+  EXPECT_TRUE(block.View().EqMatrix(m.View().Block(2, 3, 4, 5)));
+  EXPECT_FALSE(block.View().EqMatrix(m.View().Block(2, 4, 4, 5)));
+}
+
+TEST(MatrixView, Arithmetic) {
+  S21Matrix m = MakeMatrix(10, 10, 2);
+  S21Matrix expected(m);
+  S21MatrixView view = m;
+
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      expected(i + 1, j + 2) = (m(i + 1, j + 2) + m(j + 6, i + 5)) * 3.0 -
+                               m(i + 5, j);
+    }
+  }
+  S21MatrixView block = view.Block(1, 2, 4, 3);
+  block.SumMatrix(view.Block(6, 5, 3, 4).Transposed());
+  block.MulMatrix(3.0);
+  block.SubMatrix(view.Block(5, 0, 4, 3));
+
+  EXPECT_TRUE(m == expected);
+  EXPECT_THROW(block.SumMatrix(view.Block(0, 0, 3, 4)), std::invalid_argument);
+}
+
+TEST(MatrixView, Expressions) {
+  S21Matrix m = MakeMatrix(8, 8, 3);
+  S21ConstMatrixView view = m;
+  S21Matrix sum = view.Block(0, 0, 4, 4) + view.Block(4, 4, 4, 4) * 2.0;
+
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_DOUBLE_EQ(sum(i, j), m(i, j) + m(i + 4, j + 4) * 2.0);
+    }
+  }
+
+  S21Matrix copy(m);
+  m.View().Block(0, 4, 4, 4).Assign(view.Block(0, 0, 4, 4) * -1.0);
+  EXPECT_EQ(m(3, 7), -copy(3, 3));
+  EXPECT_THROW(m.View().Assign(view.Block(0, 0, 4, 4)), std::invalid_argument);
+}
+
+TEST(MatrixView, Product) {
+  S21Matrix a = MakeMatrix(70, 90, 4);
+  S21Matrix b = MakeMatrix(60, 80, 5);
+  S21ConstMatrixView lhs = a.View().Block(3, 5, 40, 50);
+  S21ConstMatrixView rhs = b.View().Block(7, 11, 30, 50).Transposed();
+
+  S21Matrix expected = NaiveProduct(lhs, rhs);
+  EXPECT_TRUE(lhs * rhs == expected);
+  EXPECT_TRUE(S21Matrix(lhs) * rhs == expected);
+  EXPECT_TRUE(lhs * S21Matrix(rhs) == expected);
+  EXPECT_THROW(lhs * lhs, std::invalid_argument);
+}
+
+TEST(MatrixView, EmptyProduct) {
+  S21Matrix a = MakeMatrix(6, 8, 6);
+  S21ConstMatrixView view = a.View();
+
+  EXPECT_THROW(view.Block(2, 0, 0, 8) * view.Transposed(),
+               std::invalid_argument);
+  EXPECT_THROW(view.Transposed() * view.Block(0, 3, 6, 0),
+               std::invalid_argument);
+  EXPECT_THROW(view.Block(0, 0, 3, 0) * view.Block(0, 0, 0, 0),
+               std::invalid_argument);
+  S21Matrix zero = view.Block(0, 0, 3, 0) * view.Block(0, 0, 0, 5);
+  EXPECT_TRUE(zero == S21Matrix(3, 5));
+}
+
+TEST(MatrixView, AddProduct) {
+  S21Matrix a = MakeMatrix(50, 50, 7);
+  S21Matrix c = MakeMatrix(64, 64, 8);
+  S21Matrix expected(c);
+  S21ConstMatrixView lhs = a.View().Block(0, 0, 20, 30);
+  S21ConstMatrixView rhs = a.View().Block(20, 10, 30, 25);
+
+  S21Matrix product = NaiveProduct(lhs, rhs);
+  for (int i = 0; i < 20; ++i) {
+    for (int j = 0; j < 25; ++j) {
+      expected(i + 10, j + 30) += product(i, j);
+      expected(j + 1, i + 2) += product(i, j);
+    }
+  }
+  c.View().Block(10, 30, 20, 25).AddProduct(lhs, rhs);
+  c.View().Block(1, 2, 25, 20).Transposed().AddProduct(lhs, rhs);
+
+  EXPECT_TRUE(c == expected);
+  EXPECT_THROW(c.View().Block(0, 0, 20, 24).AddProduct(lhs, rhs),
+               std::invalid_argument);
+}
@@ -0,0 +1,77 @@
+#include "s21_out_of_core.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+namespace {
+
+std::string TempPath(const std::string& name) {
+  return (testing::TempDir() + "s21_out_of_core_test_" + name);
+}
+
+S21Matrix MakeMatrix(int rows, int cols, int seed) {
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      m(i, j) = ((i * 7 + j * 13 + seed) % 17 - 8.0) / 8.0;
+    }
+  }
+
+  return (m);
+}
+
+}  // namespace
+
+TEST(OutOfCore, MemoryBudget) {
+  S21OutOfCoreMultiplier multiplier;
+  EXPECT_EQ(multiplier.memory_budget(),
+            S21OutOfCoreMultiplier::kDefaultMemoryBudget);
+
+  multiplier.set_memory_budget(5 * 8 * 100 * 100);
+  EXPECT_EQ(multiplier.tile_size(), 100);
+  EXPECT_THROW(multiplier.set_memory_budget(1000), std::invalid_argument);
+  EXPECT_EQ(multiplier.tile_size(), 100);
+  EXPECT_THROW(S21OutOfCoreMultiplier(0), std::invalid_argument);
+}
+
+TEST(OutOfCore, MatchesInMemoryProduct) {
+  const int kShapes[][3] = {{70, 50, 90}, {1, 33, 1}, {129, 64, 17}};
+  std::string a_path = TempPath("a"), b_path = TempPath("b");
+  std::string c_path = TempPath("c");
+
+  for (const auto& shape : kShapes) {
+    S21Matrix a = MakeMatrix(shape[0], shape[1], 1);
+    S21Matrix b = MakeMatrix(shape[1], shape[2], 5);
+    a.Save(a_path);
+    b.Save(b_path);
+
+    S21OutOfCoreMultiplier(5 * 8 * 16 * 16).Multiply(a_path, b_path, c_path);
+    S21Matrix c = S21Matrix::Load(c_path, true);
+    EXPECT_TRUE(c == a * b);
+  }
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+  std::remove(c_path.c_str());
+}
+
+TEST(OutOfCore, InvalidOperands) {
+  std::string a_path = TempPath("bad_a"), b_path = TempPath("bad_b");
+  std::string c_path = TempPath("bad_c");
+  MakeMatrix(10, 20, 0).Save(a_path);
+  MakeMatrix(10, 20, 0).Save(b_path);
+  S21OutOfCoreMultiplier multiplier;
+
+  EXPECT_THROW(multiplier.Multiply(a_path, b_path, c_path),
+               std::invalid_argument);
+  MakeMatrix(20, 20, 0).Save(b_path);
+  EXPECT_THROW(multiplier.Multiply(a_path, b_path, a_path),
+               std::invalid_argument);
+  EXPECT_TRUE(S21Matrix::Load(a_path, true) == MakeMatrix(10, 20, 0));
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+  std::remove(c_path.c_str());
+}
@@ -0,0 +1,145 @@
+#include "s21_sparse_matrix.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+
+const S21SparseMatrix::Format kFormats[] = {S21SparseMatrix::Format::kCsr,
+                                            S21SparseMatrix::Format::kCsc};
+
+// About one element in five is nonzero.
+S21Matrix MakeSparse(int rows, int cols, double shift) {
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      if ((i * 7 + j * 3) % 5 == 0) {
+        m(i, j) = ((i * 5 + j) % 9 - 4.0) / 2.0 + shift;
+      }
+    }
+  }
+
+  return (m);
+}
+
+}  // namespace
+
+TEST(SparseMatrix, DenseRoundTrip) {
+  S21Matrix dense = MakeSparse(9, 13, 0.25);
+  for (S21SparseMatrix::Format format : kFormats) {
+    S21SparseMatrix sparse(dense, format);
+    EXPECT_EQ(sparse.format(), format);
+    EXPECT_EQ(sparse.rows(), 9);
+    EXPECT_EQ(sparse.cols(), 13);
+    EXPECT_LT(sparse.nonzeros(), 9u * 13u / 4u);
+    EXPECT_EQ(sparse.offsets().back(), sparse.nonzeros());
+    EXPECT_TRUE(sparse.ToDense() == dense);
+    for (int i = 0; i < 9; ++i) {
+      for (int j = 0; j < 13; ++j) {
+        EXPECT_EQ(sparse(i, j), dense(i, j));
+      }
+    }
+  }
+}
+
+TEST(SparseMatrix, FromTriplets) {
+  std::vector<S21SparseMatrix::Triplet> triplets = {
+      {2, 1, 3.0}, {0, 3, -1.0}, {2, 0, 5.0}, {2, 1, 4.0}, {1, 1, 2.0},
+      {1, 1, -2.0}};
+  for (S21SparseMatrix::Format format : kFormats) {
+    S21SparseMatrix sparse =
+        S21SparseMatrix::FromTriplets(3, 4, triplets, format);
+    EXPECT_EQ(sparse.nonzeros(), 3u);
+    EXPECT_EQ(sparse(2, 1), 7.0);
+    EXPECT_EQ(sparse(0, 3), -1.0);
+    EXPECT_EQ(sparse(2, 0), 5.0);
+    EXPECT_EQ(sparse(1, 1), 0.0);
+  }
+
+  EXPECT_THROW(S21SparseMatrix::FromTriplets(3, 4, {{3, 0, 1.0}}),
+               std::out_of_range);
+  EXPECT_THROW(S21SparseMatrix::FromTriplets(3, 4, {{0, -1, 1.0}}),
+               std::out_of_range);
+}
+
+TEST(SparseMatrix, ConvertAndTranspose) {
+  S21Matrix dense = MakeSparse(11, 6, -0.5);
+  S21SparseMatrix csr(dense);
+  S21SparseMatrix csc = csr.ToFormat(S21SparseMatrix::Format::kCsc);
+  EXPECT_EQ(csc.format(), S21SparseMatrix::Format::kCsc);
+  EXPECT_TRUE(csc == S21SparseMatrix(dense, S21SparseMatrix::Format::kCsc));
+  EXPECT_EQ(csc.indices(),
+            S21SparseMatrix(dense, S21SparseMatrix::Format::kCsc).indices());
+  EXPECT_TRUE(csc.ToFormat(S21SparseMatrix::Format::kCsr) == csr);
+
+  S21SparseMatrix transposed = csr.Transpose();
+  EXPECT_EQ(transposed.rows(), 6);
+  EXPECT_EQ(transposed.cols(), 11);
+  EXPECT_TRUE(transposed.ToDense() == dense.Transpose());
+}
+
+TEST(SparseMatrix, MulVector) {
+  S21Matrix dense = MakeSparse(7, 10, 1.0);
+  std::vector<double> x(10);
+  for (int j = 0; j < 10; ++j) {
+    x[j] = j * 0.5 - 2.0;
+  }
+  for (S21SparseMatrix::Format format : kFormats) {
+    std::vector<double> y = S21SparseMatrix(dense, format) * x;
+    ASSERT_EQ(y.size(), 7u);
+    for (int i = 0; i < 7; ++i) {
+      double expected = 0.0;
+      for (int j = 0; j < 10; ++j) {
+        expected += dense(i, j) * x[j];
+      }
+      EXPECT_DOUBLE_EQ(y[i], expected);
+    }
+  }
+
+  EXPECT_THROW(S21SparseMatrix(dense) * std::vector<double>(7),
+               std::invalid_argument);
+}
+
+TEST(SparseMatrix, MulDense) {
+  S21Matrix a = MakeSparse(12, 9, 0.5);
+  S21Matrix b = MakeSparse(9, 14, -1.5) + S21Matrix(9, 14) * 1.0;
+  S21Matrix c = MakeSparse(5, 12, 2.0);
+  for (S21SparseMatrix::Format format : kFormats) {
+    S21SparseMatrix sparse(a, format);
+    EXPECT_TRUE(sparse * b == a * b);
+    EXPECT_TRUE(c * sparse == c * a);
+    EXPECT_THROW(sparse * c, std::invalid_argument);
+    EXPECT_THROW(b * sparse, std::invalid_argument);
+  }
+}
+
+TEST(SparseMatrix, Arithmetic) {
+  S21Matrix a = MakeSparse(8, 8, 0.0);
+  S21Matrix b = MakeSparse(8, 8, 0.75).Transpose();
+  S21SparseMatrix lhs(a);
+  S21SparseMatrix rhs(b, S21SparseMatrix::Format::kCsc);
+
+  EXPECT_TRUE((lhs + rhs).ToDense() == a + b);
+  EXPECT_TRUE((lhs - rhs).ToDense() == a - b);
+  EXPECT_TRUE((lhs * 2.5).ToDense() == a * 2.5);
+  EXPECT_EQ((lhs - lhs).nonzeros(), 0u);
+  EXPECT_EQ((lhs * 0.0).nonzeros(), 0u);
+
+  lhs += rhs;
+  lhs -= rhs;
+  EXPECT_TRUE(lhs == S21SparseMatrix(a));
+  EXPECT_FALSE(lhs == rhs);
+  EXPECT_FALSE(lhs == S21SparseMatrix(8, 9));
+  EXPECT_THROW(lhs + S21SparseMatrix(8, 9), std::invalid_argument);
+}
+
+TEST(SparseMatrix, InvalidArguments) {
+  EXPECT_THROW(S21SparseMatrix(0, 3), std::invalid_argument);
+  EXPECT_THROW(S21SparseMatrix(3, 0), std::invalid_argument);
+  S21SparseMatrix sparse(2, 3);
+  EXPECT_EQ(sparse.nonzeros(), 0u);
+  EXPECT_EQ(sparse(1, 2), 0.0);
+  EXPECT_THROW(sparse(2, 0), std::out_of_range);
+  EXPECT_THROW(sparse(0, 3), std::out_of_range);
+}
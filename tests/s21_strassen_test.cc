@@ -0,0 +1,126 @@
+#include "s21_strassen.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "s21_gemm.h"
+#include "s21_matrix_oop.h"
+
+namespace {
+
+std::vector<double> MakeData(int rows, int cols, double shift) {
+  std::vector<double> data(static_cast<std::size_t>(rows) * cols);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = std::sin(static_cast<double>(i) * 0.37 + shift);
+  }
+
+  return (data);
+}
+
+double MaxAbs(const std::vector<double>& data) {
+  double max_abs = 0.0;
+  for (double value : data) {
+    max_abs = std::max(max_abs, std::fabs(value));
+  }
+
+  return (max_abs);
+}
+
+// Forward error bounds to first order in the unit roundoff u, with |A| the
+// largest magnitude of an element of A, after Higham, "Accuracy and
+// Stability of Numerical Algorithms", chapter 23:
+//   standard product:  |C - fl(AB)| <= n^2 u |A| |B|
+//   Strassen-Winograd: |C - fl(AB)| <= ((n / n0)^log2(18) (n0^2 + 6 n0)
+//                                       - 6 n) u |A| |B|
+// where n is the largest dimension and n0 the order at which the recursion
+// stops. The Winograd variant saves three additions per level over
+// Strassen's original, whose exponent is log2(12), for a faster growing
+// constant.
+double StandardBound(int n, double norms) {
+  return (static_cast<double>(n) * n * std::numeric_limits<double>::epsilon() /
+          2.0 * norms);
+}
+
+double StrassenBound(int n, int n0, double norms) {
+  double levels = std::pow(static_cast<double>(n) / n0, std::log2(18.0));
+  return ((levels * (n0 * n0 + 6.0 * n0) - 6.0 * n) *
+          std::numeric_limits<double>::epsilon() / 2.0 * norms);
+}
+
+// Compares against the standard product; their difference is bounded by the
+// sum of both bounds.
+void CheckProduct(int m, int n, int k, int crossover) {
+  std::vector<double> a = MakeData(m, k, 0.5);
+  std::vector<double> b = MakeData(k, n, 1.5);
+  std::vector<double> expected(static_cast<std::size_t>(m) * n, 0.0);
+  std::vector<double> c(expected.size(), 7.0);
+  s21::Gemm(m, n, k, a.data(), k, 1, b.data(), n, 1, expected.data(), n, 1);
+  s21::StrassenGemm(m, n, k, a.data(), k, b.data(), n, c.data(), n,
+                    crossover);
+
+  int size = std::max({m, n, k});
+  double norms = MaxAbs(a) * MaxAbs(b);
+  double bound = StandardBound(size, norms) +
+                 StrassenBound(size, std::min(crossover, size), norms);
+  for (std::size_t i = 0; i < c.size(); ++i) {
+    ASSERT_LE(std::fabs(c[i] - expected[i]), bound) << m << " " << n << " "
+                                                    << k << " " << i;
+  }
+}
+
+}  // namespace
+
+TEST(MatrixStrassen, MatchesStandardProduct) {
+  CheckProduct(64, 64, 64, 8);
+  CheckProduct(65, 63, 67, 8);
+  CheckProduct(40, 90, 31, 4);
+  CheckProduct(1, 5, 3, 4);
+  CheckProduct(20, 20, 20, 64);
+}
+
+TEST(MatrixStrassen, RecursionAddsRoundingError) {
+  int n = 128;
+  std::vector<double> a = MakeData(n, n, 0.5);
+  std::vector<double> b = MakeData(n, n, 1.5);
+  std::vector<double> blocked(static_cast<std::size_t>(n) * n, 0.0);
+  std::vector<double> strassen(blocked.size());
+  s21::Gemm(n, n, n, a.data(), n, 1, b.data(), n, 1, blocked.data(), n, 1);
+  s21::StrassenGemm(n, n, n, a.data(), n, b.data(), n, strassen.data(), n,
+                    16);
+
+  // The two products round differently, but stay far inside the bound.
+  double error = 0.0;
+  for (std::size_t i = 0; i < blocked.size(); ++i) {
+    error = std::max(error, std::fabs(blocked[i] - strassen[i]));
+  }
+  double norms = MaxAbs(a) * MaxAbs(b);
+  EXPECT_GT(error, 0.0);
+  EXPECT_LT(error, StrassenBound(n, 16, norms) / 100.0);
+}
+
+TEST(MatrixStrassen, MulMatrix) {
+  int n = s21::kStrassenCrossover + 3;
+  S21Matrix a(n, n);
+  S21Matrix b(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a(i, j) = std::sin(i * 0.37 + j * 0.11);
+      b(i, j) = std::cos(i * 0.23 - j * 0.19);
+    }
+  }
+
+  S21Matrix blocked(a);
+  blocked.MulMatrix(b, S21Matrix::Multiplication::kBlocked);
+  S21Matrix strassen(a);
+  strassen.MulMatrix(b, S21Matrix::Multiplication::kStrassen);
+  EXPECT_TRUE(blocked == a * b);
+  EXPECT_TRUE(strassen == blocked);
+
+  S21Matrix small(3, 2);
+  EXPECT_THROW(small.MulMatrix(small, S21Matrix::Multiplication::kStrassen),
+               std::invalid_argument);
+}
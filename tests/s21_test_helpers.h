@@ -0,0 +1,55 @@
+#ifndef S21_TEST_HELPERS_H_
+#define S21_TEST_HELPERS_H_
+
+#include <cstddef>
+
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_oop.h"
+
+// Helpers shared by the test files, which are all linked into one binary.
+
+namespace s21 {
+namespace test {
+
+// A well-scaled matrix of quarters in [-1.25, 1.25], with diagonal added
+// on the diagonal; a large diagonal makes it well conditioned. Different
+// seeds give different matrices.
+inline S21Matrix MakeMatrix(int rows, int cols, int seed,
+                            double diagonal = 0.0) {
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      m(i, j) = ((i * 7 + j * 3 + seed * 5) % 11 - 5.0) / 4.0 +
+                (i == j ? diagonal : 0.0);
+    }
+  }
+
+  return (m);
+}
+
+// Forwards to the system allocator and counts, in stats(), the matrix
+// storage allocated while it is current, without touching any other
+// allocation of the test binary.
+class CountingAllocator : public S21MatrixAllocator {
+ public:
+  void* Allocate(std::size_t bytes) override {
+    void* ptr = S21MatrixAllocator::System().Allocate(bytes);
+    CountAllocation(bytes);
+
+    return (ptr);
+  }
+
+  void Deallocate(void* ptr, std::size_t bytes) noexcept override {
+    S21MatrixAllocator::System().Deallocate(ptr, bytes);
+    CountDeallocation(bytes);
+  }
+
+  std::size_t allocations(void) const noexcept {
+    return (stats().allocations);
+  }
+};
+
+}  // namespace test
+}  // namespace s21
+
+#endif  // S21_TEST_HELPERS_H_